@@ -0,0 +1,73 @@
+#pragma once
+#include <vector>
+#include <cstdint>
+#include "Exceptions.h"
+#include "NeighborRange.h"
+#include "GraphEdge.h"
+
+// Bit-packed adjacency of an unweighted undirected graph.
+// Each node owns a row of 64 bit words with one bit per column, so
+// degrees come from popcount and neighbors from find-next-set-bit.
+// Both triangles are kept so that every row is contiguous, which is
+// still 32 times smaller than the triangle of a SymMatrix<long>
+template <typename T>
+class BitAdjacency
+{
+  public:
+    // Desc: Instantiates an adjacency with the given number of nodes and no edges
+    // Pre: Size must be >= 0
+    // Post: An empty adjacency of the given size will be created
+    BitAdjacency(const long size = 1);
+
+    // Desc: Rebuilds the adjacency from a collection of node pairs
+    // Pre: Every id in edges must be between 0 and size - 1
+    // Post: The adjacency will hold size nodes with the given edges set,
+    // weights are not kept
+    template <typename EdgeContainer>
+    void Build(const long size, const EdgeContainer& edges);
+
+    // Desc: Returns the number of nodes
+    // Pre: None
+    // Post: The number of nodes is returned
+    inline long GetSize() const { return node_count; }
+
+    // Desc: Returns the number of neighbors of a node
+    // Pre: idx must be between 0 and the size - 1
+    // Post: The popcount of the node's row is returned
+    long GetDegree(const long idx) const;
+    // Desc: Returns the neighbors of a node
+    // Pre: idx must be between 0 and the size - 1
+    // Post: The sorted neighbor ids are copied into a new vector
+    std::vector<long> GetNeighbors(const long idx) const;
+    // Desc: Returns a view of the neighbors of a node
+    // Pre: idx must be between 0 and the size - 1
+    // Post: A range over the set bits of the node's row is returned
+    NeighborRange Neighbors(const long idx) const;
+    // Desc: Checks whether an edge is stored
+    // Pre: node_a and node_b must be between 0 and the size - 1
+    // Post: Returns true if the edge's bit is set
+    bool HasEdge(const long node_a, const long node_b) const;
+    // Desc: Returns the weight of an edge
+    // Pre: node_a and node_b must be between 0 and the size - 1
+    // Post: Returns 1 if the edge exists, otherwise 0
+    T GetEdgeWeight(const long node_a, const long node_b) const;
+    // Desc: Sets or clears an edge
+    // Pre: node_a and node_b must be between 0 and the size - 1
+    // Post: The edge is present if weight is non-zero, otherwise absent
+    void SetEdgeWeight(const long node_a, const long node_b, const T weight);
+
+  protected:
+    void CheckIndex(const long idx) const;
+    inline const uint64_t* Row(const long idx) const { return bits.data() + idx * row_words; }
+    inline uint64_t* Row(const long idx) { return bits.data() + idx * row_words; }
+    void SetBit(const long row, const long col, const bool value);
+
+    // the number of nodes
+    long node_count;
+    // the number of words in each row
+    long row_words;
+    // row i occupies bits[i * row_words] .. bits[(i + 1) * row_words - 1]
+    std::vector<uint64_t> bits;
+};
+
+#include "BitAdjacency.hpp"
@@ -0,0 +1,89 @@
+template <typename T>
+BitAdjacency<T>::BitAdjacency(const long size)
+: node_count(size), row_words((size + 63) / 64), bits(size * ((size + 63) / 64), 0)
+{
+}
+
+template <typename T>
+template <typename EdgeContainer>
+void BitAdjacency<T>::Build(const long size, const EdgeContainer& edges)
+{
+  node_count = size;
+  row_words = (node_count + 63) / 64;
+  bits.assign(node_count * row_words, 0);
+
+  for (const auto& edge : edges)
+  {
+    auto a = EdgeSource(edge);
+    auto b = EdgeTarget(edge);
+    CheckIndex(a);
+    CheckIndex(b);
+    SetBit(a, b, true);
+    SetBit(b, a, true);
+  }
+}
+
+template <typename T>
+long BitAdjacency<T>::GetDegree(const long idx) const
+{
+  CheckIndex(idx);
+  long degree = 0;
+  const uint64_t* row = Row(idx);
+  for (long i = 0; i < row_words; i++)
+    degree += __builtin_popcountll(row[i]);
+  return degree;
+}
+
+template <typename T>
+std::vector<long> BitAdjacency<T>::GetNeighbors(const long idx) const
+{
+  auto neighbors = Neighbors(idx);
+  return std::vector<long>(neighbors.begin(), neighbors.end());
+}
+
+template <typename T>
+NeighborRange BitAdjacency<T>::Neighbors(const long idx) const
+{
+  CheckIndex(idx);
+  return NeighborRange(Row(idx), node_count);
+}
+
+template <typename T>
+bool BitAdjacency<T>::HasEdge(const long node_a, const long node_b) const
+{
+  CheckIndex(node_a);
+  CheckIndex(node_b);
+  return ((Row(node_a)[node_b >> 6] >> (node_b & 63)) & 1) != 0;
+}
+
+template <typename T>
+T BitAdjacency<T>::GetEdgeWeight(const long node_a, const long node_b) const
+{
+  return (HasEdge(node_a, node_b) ? T(1) : T(0));
+}
+
+template <typename T>
+void BitAdjacency<T>::SetEdgeWeight(const long node_a, const long node_b, const T weight)
+{
+  CheckIndex(node_a);
+  CheckIndex(node_b);
+  SetBit(node_a, node_b, weight != 0);
+  SetBit(node_b, node_a, weight != 0);
+}
+
+template <typename T>
+void BitAdjacency<T>::CheckIndex(const long idx) const
+{
+  if (idx < 0 || idx >= node_count)
+    throw SubscriptErr(idx);
+}
+
+template <typename T>
+void BitAdjacency<T>::SetBit(const long row, const long col, const bool value)
+{
+  uint64_t mask = uint64_t(1) << (col & 63);
+  if (value)
+    Row(row)[col >> 6] |= mask;
+  else
+    Row(row)[col >> 6] &= ~mask;
+}
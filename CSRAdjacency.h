@@ -0,0 +1,86 @@
+#pragma once
+#include <vector>
+#include <algorithm>
+#include "Exceptions.h"
+#include "NeighborRange.h"
+#include "GraphEdge.h"
+
+// Compressed sparse row adjacency of a weighted undirected graph.
+// Each edge is stored in the rows of both of its endpoints, so
+// the neighbors of a node are one contiguous, sorted run with
+// their edge weights in a parallel array
+template <typename T>
+class CSRAdjacency
+{
+  public:
+    // Desc: Instantiates an adjacency with the given number of nodes and no edges
+    // Pre: Size must be >= 0
+    // Post: An empty adjacency of the given size will be created
+    CSRAdjacency(const long size = 1);
+
+    // Desc: Rebuilds the adjacency from a collection of node pairs,
+    // bare pairs get weight 1 (see GraphEdge.h)
+    // Pre: Every id in edges must be between 0 and size - 1
+    // Post: The adjacency will hold size nodes and one entry per
+    // distinct undirected edge in each endpoint's row
+    template <typename EdgeContainer>
+    void Build(const long size, const EdgeContainer& edges);
+
+    // Desc: Returns the number of nodes
+    // Pre: None
+    // Post: The number of nodes is returned
+    inline long GetSize() const { return node_count; }
+    // Desc: Returns the number of stored row entries (twice the edge count,
+    // less one for each self loop)
+    // Pre: None
+    // Post: The length of the neighbor array is returned
+    inline long GetEntryCount() const { return static_cast<long>(neighbors.size()); }
+
+    // Desc: Returns the number of neighbors of a node
+    // Pre: idx must be between 0 and the size - 1
+    // Post: The degree of the node is returned in O(1)
+    long GetDegree(const long idx) const;
+    // Desc: Returns the neighbors of a node
+    // Pre: idx must be between 0 and the size - 1
+    // Post: The sorted neighbor ids are copied into a new vector
+    std::vector<long> GetNeighbors(const long idx) const;
+    // Desc: Returns a view of the neighbors of a node
+    // Pre: idx must be between 0 and the size - 1
+    // Post: A range over the node's row is returned without copying
+    NeighborRange Neighbors(const long idx) const;
+    // Desc: Returns the edge weights of a node's neighbors
+    // Pre: idx must be between 0 and the size - 1
+    // Post: A pointer to GetDegree(idx) weights is returned, in
+    // the same order as Neighbors(idx)
+    const T* NeighborWeights(const long idx) const;
+    // Desc: Checks whether an edge is stored
+    // Pre: node_a and node_b must be between 0 and the size - 1
+    // Post: Returns true if the edge exists, found by binary search
+    bool HasEdge(const long node_a, const long node_b) const;
+    // Desc: Returns the weight of an edge
+    // Pre: node_a and node_b must be between 0 and the size - 1
+    // Post: Returns the stored weight if the edge exists, otherwise 0
+    T GetEdgeWeight(const long node_a, const long node_b) const;
+    // Desc: Inserts or removes an edge
+    // Pre: node_a and node_b must be between 0 and the size - 1
+    // Post: The edge has the given weight if it is non-zero, otherwise
+    // it is absent. Inserting or removing costs O(n + m) since the
+    // arrays after the row are shifted
+    void SetEdgeWeight(const long node_a, const long node_b, const T weight);
+
+  protected:
+    void CheckIndex(const long idx) const;
+    void Insert(const long row, const long col, const T weight);
+    void Remove(const long row, const long col);
+
+    // the number of nodes
+    long node_count;
+    // row i occupies neighbors[offsets[i]] .. neighbors[offsets[i + 1] - 1]
+    std::vector<long> offsets;
+    // the concatenated, sorted neighbor lists
+    std::vector<long> neighbors;
+    // weights[k] is the weight of the edge to neighbors[k]
+    std::vector<T> weights;
+};
+
+#include "CSRAdjacency.hpp"
@@ -0,0 +1,176 @@
+template <typename T>
+CSRAdjacency<T>::CSRAdjacency(const long size)
+: node_count(size), offsets(size + 1, 0), neighbors(), weights()
+{
+}
+
+template <typename T>
+template <typename EdgeContainer>
+void CSRAdjacency<T>::Build(const long size, const EdgeContainer& edges)
+{
+  node_count = size;
+  offsets.assign(node_count + 1, 0);
+
+  // count the entries of each row
+  for (const auto& edge : edges)
+  {
+    auto a = EdgeSource(edge);
+    auto b = EdgeTarget(edge);
+    CheckIndex(a);
+    CheckIndex(b);
+    offsets[a + 1]++;
+    if (a != b)
+      offsets[b + 1]++;
+  }
+  for (long i = 0; i < node_count; i++)
+    offsets[i + 1] += offsets[i];
+
+  // scatter both directions of every edge into its rows
+  std::vector<std::pair<long, T>> entries(offsets[node_count]);
+  std::vector<long> fill(offsets.begin(), offsets.end() - 1);
+  for (const auto& edge : edges)
+  {
+    auto a = EdgeSource(edge);
+    auto b = EdgeTarget(edge);
+    auto w = EdgeWeight<T>(edge);
+    entries[fill[a]++] = std::make_pair(b, w);
+    if (a != b)
+      entries[fill[b]++] = std::make_pair(a, w);
+  }
+
+  // sort each row and merge duplicates, (a, b) and (b, a) are the same
+  // edge and the one that came last in edges sets the weight
+  neighbors.resize(entries.size());
+  weights.resize(entries.size());
+  long write = 0;
+  for (long i = 0; i < node_count; i++)
+  {
+    auto first = entries.begin() + offsets[i];
+    auto last = entries.begin() + offsets[i + 1];
+    std::stable_sort(first, last, [](const std::pair<long, T>& lhs, const std::pair<long, T>& rhs) { return lhs.first < rhs.first; });
+
+    offsets[i] = write;
+    for (auto itr = first; itr != last; ++itr)
+    {
+      if (write > offsets[i] && neighbors[write - 1] == itr->first)
+        write--;
+      neighbors[write] = itr->first;
+      weights[write] = itr->second;
+      write++;
+    }
+  }
+  offsets[node_count] = write;
+  neighbors.resize(write);
+  neighbors.shrink_to_fit();
+  weights.resize(write);
+  weights.shrink_to_fit();
+}
+
+template <typename T>
+long CSRAdjacency<T>::GetDegree(const long idx) const
+{
+  CheckIndex(idx);
+  return offsets[idx + 1] - offsets[idx];
+}
+
+template <typename T>
+std::vector<long> CSRAdjacency<T>::GetNeighbors(const long idx) const
+{
+  CheckIndex(idx);
+  return std::vector<long>(neighbors.begin() + offsets[idx], neighbors.begin() + offsets[idx + 1]);
+}
+
+template <typename T>
+NeighborRange CSRAdjacency<T>::Neighbors(const long idx) const
+{
+  CheckIndex(idx);
+  return NeighborRange(neighbors.data() + offsets[idx], neighbors.data() + offsets[idx + 1]);
+}
+
+template <typename T>
+bool CSRAdjacency<T>::HasEdge(const long node_a, const long node_b) const
+{
+  CheckIndex(node_a);
+  CheckIndex(node_b);
+  return std::binary_search(neighbors.begin() + offsets[node_a], neighbors.begin() + offsets[node_a + 1], node_b);
+}
+
+template <typename T>
+T CSRAdjacency<T>::GetEdgeWeight(const long node_a, const long node_b) const
+{
+  CheckIndex(node_a);
+  CheckIndex(node_b);
+  auto first = neighbors.begin() + offsets[node_a];
+  auto last = neighbors.begin() + offsets[node_a + 1];
+  auto itr = std::lower_bound(first, last, node_b);
+  if (itr == last || *itr != node_b)
+    return T(0);
+  return weights[itr - neighbors.begin()];
+}
+
+template <typename T>
+const T* CSRAdjacency<T>::NeighborWeights(const long idx) const
+{
+  CheckIndex(idx);
+  return weights.data() + offsets[idx];
+}
+
+template <typename T>
+void CSRAdjacency<T>::SetEdgeWeight(const long node_a, const long node_b, const T weight)
+{
+  CheckIndex(node_a);
+  CheckIndex(node_b);
+  if (weight != 0)
+  {
+    Insert(node_a, node_b, weight);
+    if (node_a != node_b)
+      Insert(node_b, node_a, weight);
+  }
+  else
+  {
+    Remove(node_a, node_b);
+    if (node_a != node_b)
+      Remove(node_b, node_a);
+  }
+}
+
+template <typename T>
+void CSRAdjacency<T>::CheckIndex(const long idx) const
+{
+  if (idx < 0 || idx >= node_count)
+    throw SubscriptErr(idx);
+}
+
+template <typename T>
+void CSRAdjacency<T>::Insert(const long row, const long col, const T weight)
+{
+  auto first = neighbors.begin() + offsets[row];
+  auto last = neighbors.begin() + offsets[row + 1];
+  auto itr = std::lower_bound(first, last, col);
+  auto pos = itr - neighbors.begin();
+  if (itr != last && *itr == col)
+  {
+    weights[pos] = weight;
+    return;
+  }
+
+  neighbors.insert(itr, col);
+  weights.insert(weights.begin() + pos, weight);
+  for (long i = row + 1; i <= node_count; i++)
+    offsets[i]++;
+}
+
+template <typename T>
+void CSRAdjacency<T>::Remove(const long row, const long col)
+{
+  auto first = neighbors.begin() + offsets[row];
+  auto last = neighbors.begin() + offsets[row + 1];
+  auto itr = std::lower_bound(first, last, col);
+  if (itr == last || *itr != col)
+    return;
+
+  weights.erase(weights.begin() + (itr - neighbors.begin()));
+  neighbors.erase(itr);
+  for (long i = row + 1; i <= node_count; i++)
+    offsets[i]--;
+}
@@ -0,0 +1,80 @@
+#pragma once
+#include <vector>
+#include <cstdint>
+#include <algorithm>
+#include "Exceptions.h"
+#include "NeighborRange.h"
+#include "GraphEdge.h"
+
+// Compressed adjacency of an unweighted undirected graph.
+// Each row is a byte string of LEB128 varints: the degree, the first
+// neighbor as a zigzag coded offset from the node, then the gaps
+// between consecutive sorted neighbors. Sorted lists of close ids
+// need one or two bytes per neighbor instead of eight, and DFS/BFS
+// decode them on the fly through NeighborRange
+template <typename T>
+class CompressedAdjacency
+{
+  public:
+    // Desc: Instantiates an adjacency with the given number of nodes and no edges
+    // Pre: Size must be >= 0
+    // Post: An empty adjacency of the given size will be created
+    CompressedAdjacency(const long size = 1);
+
+    // Desc: Rebuilds the adjacency from a collection of node pairs
+    // Pre: Every id in edges must be between 0 and size - 1
+    // Post: The adjacency will hold size nodes with the given edges,
+    // weights are not kept
+    template <typename EdgeContainer>
+    void Build(const long size, const EdgeContainer& edges);
+
+    // Desc: Returns the number of nodes
+    // Pre: None
+    // Post: The number of nodes is returned
+    inline long GetSize() const { return node_count; }
+    // Desc: Returns the number of bytes used by the coded rows
+    // Pre: None
+    // Post: The length of the byte array is returned
+    inline long GetByteCount() const { return static_cast<long>(bytes.size()); }
+
+    // Desc: Returns the number of neighbors of a node
+    // Pre: idx must be between 0 and the size - 1
+    // Post: The degree stored at the head of the row is returned
+    long GetDegree(const long idx) const;
+    // Desc: Returns the neighbors of a node
+    // Pre: idx must be between 0 and the size - 1
+    // Post: The sorted neighbor ids are decoded into a new vector
+    std::vector<long> GetNeighbors(const long idx) const;
+    // Desc: Returns a view of the neighbors of a node
+    // Pre: idx must be between 0 and the size - 1
+    // Post: A range that decodes the node's row is returned
+    NeighborRange Neighbors(const long idx) const;
+    // Desc: Checks whether an edge is stored
+    // Pre: node_a and node_b must be between 0 and the size - 1
+    // Post: Returns true if the edge exists, found by decoding the row
+    bool HasEdge(const long node_a, const long node_b) const;
+    // Desc: Returns the weight of an edge
+    // Pre: node_a and node_b must be between 0 and the size - 1
+    // Post: Returns 1 if the edge exists, otherwise 0
+    T GetEdgeWeight(const long node_a, const long node_b) const;
+    // Desc: Inserts or removes an edge
+    // Pre: node_a and node_b must be between 0 and the size - 1
+    // Post: The edge is present if weight is non-zero, otherwise absent.
+    // Both rows are re-encoded, which costs O(n + bytes)
+    void SetEdgeWeight(const long node_a, const long node_b, const T weight);
+
+  protected:
+    void CheckIndex(const long idx) const;
+    static void WriteVarint(std::vector<uint8_t>& out, uint64_t value);
+    static void EncodeRow(std::vector<uint8_t>& out, const long node, const long* first, const long* last);
+    void ReplaceRow(const long idx, const std::vector<long>& ids);
+
+    // the number of nodes
+    long node_count;
+    // row i occupies bytes[offsets[i]] .. bytes[offsets[i + 1] - 1]
+    std::vector<long> offsets;
+    // the concatenated, coded rows
+    std::vector<uint8_t> bytes;
+};
+
+#include "CompressedAdjacency.hpp"
@@ -0,0 +1,183 @@
+template <typename T>
+CompressedAdjacency<T>::CompressedAdjacency(const long size)
+: node_count(size), offsets(size + 1, 0), bytes()
+{
+  // every empty row is a single zero degree byte
+  for (long i = 0; i < node_count; i++)
+  {
+    bytes.push_back(0);
+    offsets[i + 1] = i + 1;
+  }
+}
+
+template <typename T>
+template <typename EdgeContainer>
+void CompressedAdjacency<T>::Build(const long size, const EdgeContainer& edges)
+{
+  node_count = size;
+  offsets.assign(node_count + 1, 0);
+
+  // count the entries of each row
+  for (const auto& edge : edges)
+  {
+    auto a = EdgeSource(edge);
+    auto b = EdgeTarget(edge);
+    CheckIndex(a);
+    CheckIndex(b);
+    offsets[a + 1]++;
+    if (a != b)
+      offsets[b + 1]++;
+  }
+  for (long i = 0; i < node_count; i++)
+    offsets[i + 1] += offsets[i];
+
+  // scatter both directions of every edge into its rows, only the ids
+  std::vector<long> ids(offsets[node_count]);
+  std::vector<long> fill(offsets.begin(), offsets.end() - 1);
+  for (const auto& edge : edges)
+  {
+    auto a = EdgeSource(edge);
+    auto b = EdgeTarget(edge);
+    ids[fill[a]++] = b;
+    if (a != b)
+      ids[fill[b]++] = a;
+  }
+  std::vector<long>().swap(fill);
+
+  // edges sorted by node pair fill every row in order, so only other
+  // inputs pay for the sort. Repeated pairs are merged, then each row
+  // is coded in place of its count
+  bytes.clear();
+  bytes.reserve(ids.size() + node_count);
+  long first = 0;
+  for (long i = 0; i < node_count; i++)
+  {
+    long* row = ids.data() + first;
+    long* row_end = ids.data() + offsets[i + 1];
+    if (!std::is_sorted(row, row_end))
+      std::sort(row, row_end);
+    row_end = std::unique(row, row_end);
+
+    first = offsets[i + 1];
+    offsets[i] = static_cast<long>(bytes.size());
+    EncodeRow(bytes, i, row, row_end);
+  }
+  offsets[node_count] = static_cast<long>(bytes.size());
+  bytes.shrink_to_fit();
+}
+
+template <typename T>
+long CompressedAdjacency<T>::GetDegree(const long idx) const
+{
+  CheckIndex(idx);
+  const uint8_t* row = bytes.data() + offsets[idx];
+  return static_cast<long>(NeighborRange::const_iterator::ReadVarint(row));
+}
+
+template <typename T>
+std::vector<long> CompressedAdjacency<T>::GetNeighbors(const long idx) const
+{
+  auto neighbors = Neighbors(idx);
+  return std::vector<long>(neighbors.begin(), neighbors.end());
+}
+
+template <typename T>
+NeighborRange CompressedAdjacency<T>::Neighbors(const long idx) const
+{
+  CheckIndex(idx);
+  const uint8_t* row = bytes.data() + offsets[idx];
+  long degree = static_cast<long>(NeighborRange::const_iterator::ReadVarint(row));
+  return NeighborRange(row, degree, idx);
+}
+
+template <typename T>
+bool CompressedAdjacency<T>::HasEdge(const long node_a, const long node_b) const
+{
+  CheckIndex(node_b);
+  for (const auto n : Neighbors(node_a))
+  {
+    if (n >= node_b)
+      return (n == node_b);
+  }
+  return false;
+}
+
+template <typename T>
+T CompressedAdjacency<T>::GetEdgeWeight(const long node_a, const long node_b) const
+{
+  return (HasEdge(node_a, node_b) ? T(1) : T(0));
+}
+
+template <typename T>
+void CompressedAdjacency<T>::SetEdgeWeight(const long node_a, const long node_b, const T weight)
+{
+  CheckIndex(node_a);
+  CheckIndex(node_b);
+  if (HasEdge(node_a, node_b) == (weight != 0))
+    return;
+
+  auto row_a = GetNeighbors(node_a);
+  auto itr = std::lower_bound(row_a.begin(), row_a.end(), node_b);
+  if (weight != 0)
+    row_a.insert(itr, node_b);
+  else
+    row_a.erase(itr);
+  ReplaceRow(node_a, row_a);
+
+  if (node_a != node_b)
+  {
+    auto row_b = GetNeighbors(node_b);
+    itr = std::lower_bound(row_b.begin(), row_b.end(), node_a);
+    if (weight != 0)
+      row_b.insert(itr, node_a);
+    else
+      row_b.erase(itr);
+    ReplaceRow(node_b, row_b);
+  }
+}
+
+template <typename T>
+void CompressedAdjacency<T>::CheckIndex(const long idx) const
+{
+  if (idx < 0 || idx >= node_count)
+    throw SubscriptErr(idx);
+}
+
+template <typename T>
+void CompressedAdjacency<T>::WriteVarint(std::vector<uint8_t>& out, uint64_t value)
+{
+  while (value >= 0x80)
+  {
+    out.push_back(static_cast<uint8_t>(value | 0x80));
+    value >>= 7;
+  }
+  out.push_back(static_cast<uint8_t>(value));
+}
+
+template <typename T>
+void CompressedAdjacency<T>::EncodeRow(std::vector<uint8_t>& out, const long node, const long* first, const long* last)
+{
+  WriteVarint(out, static_cast<uint64_t>(last - first));
+  if (first == last)
+    return;
+
+  // zigzag maps small offsets of either sign to small codes
+  long offset = *first - node;
+  WriteVarint(out, (static_cast<uint64_t>(offset) << 1) ^ static_cast<uint64_t>(offset >> 63));
+  for (const long* itr = first + 1; itr != last; ++itr)
+    WriteVarint(out, static_cast<uint64_t>(*itr - *(itr - 1)));
+}
+
+template <typename T>
+void CompressedAdjacency<T>::ReplaceRow(const long idx, const std::vector<long>& ids)
+{
+  std::vector<uint8_t> row;
+  EncodeRow(row, idx, ids.data(), ids.data() + ids.size());
+
+  long old_length = offsets[idx + 1] - offsets[idx];
+  long shift = static_cast<long>(row.size()) - old_length;
+  bytes.erase(bytes.begin() + offsets[idx], bytes.begin() + offsets[idx + 1]);
+  bytes.insert(bytes.begin() + offsets[idx], row.begin(), row.end());
+  for (long i = idx + 1; i <= node_count; i++)
+    offsets[i] += shift;
+}
@@ -0,0 +1,33 @@
+#pragma once
+#include <string>
+#include <vector>
+#include <type_traits>
+#include "Exceptions.h"
+#include "EdgeListScanner.h"
+
+// Bulk parsing of the dense matrix graph format written by
+// UndirectedGraph::operator<<: the node count, one label per node, then
+// the n x n adjacency values. The label block is optional, files like
+// the shipped graph.txt go straight from the count to the rows. Tokens
+// may be split by any whitespace, including newlines
+
+// Desc: Reads the node count and the labels of a dense matrix file
+// Pre: [pos, end) must hold the file named file_name
+// Post: The node count is returned, labels holds one label per node or
+// is empty if the file has none, and pos is moved to the first value.
+// The labels are taken to be present when one of the n tokens after the
+// count is not a number, wherever the line breaks fall. All numeric labels
+// look like values and make ScanDenseRows throw. Throws FormatErr if the
+// count is missing or negative
+inline long ScanDenseHeader(const char*& pos, const char* end, std::vector<std::string>& labels, const std::string& file_name);
+
+// Desc: Reads the values of a dense matrix file
+// Pre: pos must be the position ScanDenseHeader left
+// Post: on_entry(row, col, value) is called for every non-zero value on
+// or above the diagonal, in row order. Values below the diagonal are
+// skipped without being converted. Throws FormatErr unless exactly n x n
+// values follow
+template <typename T, typename Callback>
+void ScanDenseRows(const char* pos, const char* end, const long size, Callback on_entry, const std::string& file_name);
+
+#include "DenseMatrixReader.hpp"
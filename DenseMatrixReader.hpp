@@ -0,0 +1,106 @@
+// moves pos past the next whitespace separated token and sets token to
+// its start, returns false if only whitespace is left
+inline bool NextToken(const char*& pos, const char* end, const char*& token)
+{
+  while (pos != end && (IsBlank(*pos) || *pos == '\n'))
+    ++pos;
+  if (pos == end)
+    return false;
+
+  token = pos;
+  while (pos != end && !IsBlank(*pos) && *pos != '\n')
+    ++pos;
+  return true;
+}
+
+// true if [begin, end) reads as a decimal number, with an optional sign,
+// fraction and exponent
+inline bool IsNumberToken(const char* begin, const char* end)
+{
+  auto pos = begin;
+  if (pos != end && (*pos == '-' || *pos == '+'))
+    ++pos;
+  long digits = 0;
+  for (; pos != end && *pos >= '0' && *pos <= '9'; ++pos)
+    digits++;
+  if (pos != end && *pos == '.')
+    for (++pos; pos != end && *pos >= '0' && *pos <= '9'; ++pos)
+      digits++;
+  if (digits == 0)
+    return false;
+  if (pos != end && (*pos == 'e' || *pos == 'E'))
+  {
+    ++pos;
+    if (pos != end && (*pos == '-' || *pos == '+'))
+      ++pos;
+    if (pos == end || *pos < '0' || *pos > '9')
+      return false;
+    while (pos != end && *pos >= '0' && *pos <= '9')
+      ++pos;
+  }
+  return pos == end;
+}
+
+inline long ScanDenseHeader(const char*& pos, const char* end, std::vector<std::string>& labels, const std::string& file_name)
+{
+  const char* token = nullptr;
+  if (!NextToken(pos, end, token))
+    throw FormatErr(file_name);
+  long size = ScanLong(token, pos);
+  if (size < 0)
+    throw FormatErr(file_name);
+
+  // matrix values are numbers, so a token among the next n that is not
+  // one means the label block is there
+  labels.clear();
+  bool labeled = false;
+  const char* scan = pos;
+  for (long i = 0; i < size && !labeled && NextToken(scan, end, token); i++)
+    labeled = !IsNumberToken(token, scan);
+  if (!labeled)
+    return size;
+
+  labels.reserve(size);
+  for (long i = 0; i < size; i++)
+  {
+    if (!NextToken(pos, end, token))
+      throw FormatErr(file_name);
+    labels.push_back(std::string(token, pos));
+  }
+  return size;
+}
+
+template <typename T, typename Callback>
+void ScanDenseRows(const char* pos, const char* end, const long size, Callback on_entry, const std::string& file_name)
+{
+  const char* token = nullptr;
+  for (long row = 0; row < size; row++)
+  {
+    // the lower triangle mirrors the upper one, so it is only stepped over
+    for (long col = 0; col < row; col++)
+      if (!NextToken(pos, end, token))
+        throw FormatErr(file_name);
+
+    for (long col = row; col < size; col++)
+    {
+      if (!NextToken(pos, end, token))
+        throw FormatErr(file_name);
+
+      T value(0);
+      if (std::is_integral<T>::value)
+        value = static_cast<T>(ScanLong(token, pos));
+      else
+      {
+        double real = 0;
+        ScanDoubleToken(token, pos, real);
+        value = static_cast<T>(real);
+      }
+      if (value != 0)
+        on_entry(row, col, value);
+    }
+  }
+
+  // anything left over means the file is not n x n
+  if (NextToken(pos, end, token))
+    throw FormatErr(file_name);
+}
@@ -0,0 +1,50 @@
+#pragma once
+#include <string>
+#include <cstring>
+#include <cmath>
+
+// Allocation free scanning of "a<delim>b<delim>weight" edge lists held
+// in memory, such as a MappedFile. Fields are split on the delimiter
+// and read the way atoi reads them, so the results match splitting
+// each line with split() and calling atoi on the first three fields
+
+// Desc: Checks for a blank, whitespace other than a newline
+// Pre: None
+// Post: Returns true if c is a space, tab, carriage return, vertical tab or form feed
+inline bool IsBlank(const char c);
+
+// Desc: Reads an integer from the start of a field
+// Pre: [pos, end) must be a readable range
+// Post: Leading blanks are skipped and the optionally signed digits
+// that follow are returned, or 0 if there are none
+inline long ScanLong(const char* pos, const char* end);
+
+// Desc: Finds the first occurrence of the delimiter in a range
+// Pre: delimiter must not be empty
+// Post: A pointer to the delimiter is returned, or end if there is none
+inline const char* FindDelimiter(const char* pos, const char* end, const std::string& delimiter);
+
+// Desc: Finds the end of the line that pos is on
+// Pre: [pos, end) must be a readable range
+// Post: A pointer to the newline is returned, or end if there is none
+inline const char* LineEnd(const char* pos, const char* end);
+
+// Desc: Reads the next blank separated integer of a line
+// Pre: [pos, end) must be a readable range within one line
+// Post: Returns false if only blanks are left, otherwise the token is
+// read as by ScanLong into value and pos is moved past it
+inline bool ScanLongToken(const char*& pos, const char* end, long& value);
+
+// Desc: Reads the next blank separated decimal number of a line
+// Pre: [pos, end) must be a readable range within one line
+// Post: Returns false if only blanks are left, otherwise the token is
+// read into value, allowing a fraction and an exponent, and pos is moved past it
+inline bool ScanDoubleToken(const char*& pos, const char* end, double& value);
+
+// Desc: Calls on_edge(a, b, weight) for every line of an edge list
+// Pre: delimiter must not be empty
+// Post: Lines with fewer than three fields, such as blank lines, are skipped
+template <typename Callback>
+void ScanEdgeList(const char* begin, const char* end, const std::string& delimiter, Callback on_edge);
+
+#include "EdgeListScanner.hpp"
@@ -0,0 +1,119 @@
+inline bool IsBlank(const char c)
+{
+  return (c == ' ' || c == '\t' || c == '\r' || c == '\v' || c == '\f');
+}
+
+inline long ScanLong(const char* pos, const char* end)
+{
+  while (pos != end && IsBlank(*pos))
+    ++pos;
+
+  bool negative = false;
+  if (pos != end && (*pos == '-' || *pos == '+'))
+    negative = (*pos++ == '-');
+
+  long value = 0;
+  while (pos != end && *pos >= '0' && *pos <= '9')
+    value = value * 10 + (*pos++ - '0');
+  return (negative ? -value : value);
+}
+
+inline const char* FindDelimiter(const char* pos, const char* end, const std::string& delimiter)
+{
+  const char first = delimiter[0];
+  const std::size_t length = delimiter.size();
+  while (pos != end)
+  {
+    pos = static_cast<const char*>(std::memchr(pos, first, end - pos));
+    if (pos == nullptr)
+      return end;
+    if (static_cast<std::size_t>(end - pos) >= length && std::memcmp(pos, delimiter.data(), length) == 0)
+      return pos;
+    ++pos;
+  }
+  return end;
+}
+
+inline const char* LineEnd(const char* pos, const char* end)
+{
+  auto eol = static_cast<const char*>(std::memchr(pos, '\n', end - pos));
+  return (eol == nullptr ? end : eol);
+}
+
+inline bool ScanLongToken(const char*& pos, const char* end, long& value)
+{
+  while (pos != end && IsBlank(*pos))
+    ++pos;
+  if (pos == end)
+    return false;
+
+  auto token_end = pos;
+  while (token_end != end && !IsBlank(*token_end))
+    ++token_end;
+  value = ScanLong(pos, token_end);
+  pos = token_end;
+  return true;
+}
+
+inline bool ScanDoubleToken(const char*& pos, const char* end, double& value)
+{
+  while (pos != end && IsBlank(*pos))
+    ++pos;
+  if (pos == end)
+    return false;
+
+  auto token_end = pos;
+  while (token_end != end && !IsBlank(*token_end))
+    ++token_end;
+
+  bool negative = false;
+  if (pos != token_end && (*pos == '-' || *pos == '+'))
+    negative = (*pos++ == '-');
+  value = 0;
+  while (pos != token_end && *pos >= '0' && *pos <= '9')
+    value = value * 10 + (*pos++ - '0');
+  if (pos != token_end && *pos == '.')
+  {
+    double scale = 0.1;
+    for (++pos; pos != token_end && *pos >= '0' && *pos <= '9'; scale *= 0.1)
+      value += (*pos++ - '0') * scale;
+  }
+  if (pos != token_end && (*pos == 'e' || *pos == 'E'))
+    value *= std::pow(10.0, static_cast<double>(ScanLong(pos + 1, token_end)));
+  if (negative)
+    value = -value;
+
+  pos = token_end;
+  return true;
+}
+
+template <typename Callback>
+void ScanEdgeList(const char* begin, const char* end, const std::string& delimiter, Callback on_edge)
+{
+  const char* line = begin;
+  while (line < end)
+  {
+    auto eol = LineEnd(line, end);
+
+    // each field runs up to the next delimiter, so an empty field
+    // reads as 0 rather than borrowing the value after it
+    long fields[3];
+    const char* field = line;
+    long count = 0;
+    for (; count < 3; count++)
+    {
+      auto field_end = FindDelimiter(field, eol, delimiter);
+      fields[count] = ScanLong(field, field_end);
+      if (field_end == eol)
+      {
+        count++;
+        break;
+      }
+      field = field_end + delimiter.size();
+    }
+
+    if (count == 3)
+      on_edge(fields[0], fields[1], fields[2]);
+    line = eol + 1;
+  }
+}
@@ -48,6 +48,21 @@ class SubscriptErr : public MatrixErr
     long index = -1;
 };
 
+// The Get/Set element accessors of Vector and SymMatrix only check
+// their subscripts in debug builds, compiling with NDEBUG removes
+// the check so the accessors inline down to a plain load or store
+#ifdef NDEBUG
+const bool CHECK_SUBSCRIPTS = false;
+#else
+const bool CHECK_SUBSCRIPTS = true;
+#endif
+
+inline void CheckSubscript(const long i, const long size)
+{
+  if (CHECK_SUBSCRIPTS && (i < 0 || i >= size))
+    throw SubscriptErr(i);
+}
+
 class DivByZeroErr : public MatrixErr
 {
   public:
@@ -77,4 +92,31 @@ class NodeNameErr : public MatrixErr
     std::string name;
 };
 
+class FrozenGraphErr : public MatrixErr
+{
+  public:
+    FrozenGraphErr();
+    virtual string what() const;
+};
+
+class FileErr : public MatrixErr
+{
+  public:
+    FileErr();
+    FileErr(const std::string& file_name);
+    virtual string what() const;
+  private:
+    std::string name;
+};
+
+class FormatErr : public MatrixErr
+{
+  public:
+    FormatErr();
+    FormatErr(const std::string& file_name);
+    virtual string what() const;
+  private:
+    std::string name;
+};
+
 #include "Exceptions.hpp"
\ No newline at end of file
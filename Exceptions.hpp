@@ -146,4 +146,39 @@ std::string NodeNameErr::what() const
 {
   std::string err("Node label not found in graph: " + name);
   return err;
-}
\ No newline at end of file
+}
+
+FrozenGraphErr::FrozenGraphErr(){}
+
+std::string FrozenGraphErr::what() const
+{
+  return "Graph is frozen and cannot be modified.";
+}
+
+FileErr::FileErr()
+: name("")
+{}
+
+FileErr::FileErr(const std::string& file_name)
+: name(file_name)
+{}
+
+std::string FileErr::what() const
+{
+  std::string err("Could not open file: " + name);
+  return err;
+}
+
+FormatErr::FormatErr()
+: name("")
+{}
+
+FormatErr::FormatErr(const std::string& file_name)
+: name(file_name)
+{}
+
+std::string FormatErr::what() const
+{
+  std::string err("Unrecognized or corrupt graph file: " + name);
+  return err;
+}
@@ -0,0 +1,24 @@
+#pragma once
+#include <utility>
+
+// The adjacency Build functions accept containers of either bare
+// (a, b) node pairs, which are unweighted, or ((a, b), weight)
+// entries such as those of a std::map keyed on the node pair
+inline long EdgeSource(const std::pair<long, long>& edge) { return edge.first; }
+inline long EdgeTarget(const std::pair<long, long>& edge) { return edge.second; }
+template <typename T>
+inline T EdgeWeight(const std::pair<long, long>&) { return T(1); }
+
+template <typename W>
+inline long EdgeSource(const std::pair<const std::pair<long, long>, W>& edge) { return edge.first.first; }
+template <typename W>
+inline long EdgeTarget(const std::pair<const std::pair<long, long>, W>& edge) { return edge.first.second; }
+template <typename T, typename W>
+inline T EdgeWeight(const std::pair<const std::pair<long, long>, W>& edge) { return static_cast<T>(edge.second); }
+
+template <typename W>
+inline long EdgeSource(const std::pair<std::pair<long, long>, W>& edge) { return edge.first.first; }
+template <typename W>
+inline long EdgeTarget(const std::pair<std::pair<long, long>, W>& edge) { return edge.first.second; }
+template <typename T, typename W>
+inline T EdgeWeight(const std::pair<std::pair<long, long>, W>& edge) { return static_cast<T>(edge.second); }
@@ -0,0 +1,58 @@
+#pragma once
+#include <string>
+#include <vector>
+#include <utility>
+#include "Exceptions.h"
+#include "EdgeListScanner.h"
+#include "GraphSnapshot.h"
+
+// Graph file formats the driver can load. Text is this repo's
+// "a b weight" edge list and Snapshot the binary format of
+// GraphSnapshot.h. The others are read in place from a MappedFile by
+// the parsers below, which append each undirected edge as a
+// ((low, high), weight) entry and return the number of nodes
+//   Metis         the METIS .graph format, 1 based adjacency lines
+//   MatrixMarket  Matrix Market coordinate files, 1 based entries
+//   Snap          SNAP edge lists, '#' comments and "a b" lines
+// Node ids keep the numbering of the file, as the Text loader does, so
+// structure files, updates and output use the same ids as the graph
+// file. The 1 based formats therefore hold an extra node 0 without edges
+// DenseMatrix is the n x n format of UndirectedGraph::operator>>, read
+// by the ReadDenseMatrix functions of the graphs
+enum class GraphFileFormat { Text, Snapshot, Metis, MatrixMarket, Snap, DenseMatrix };
+
+// Desc: Guesses the format of a graph file
+// Pre: None
+// Post: The snapshot magic and the Matrix Market banner are checked
+// first, then the .mtx, .graph and .metis extensions. Files that start
+// with '#' comments or whose first line holds two blank separated
+// fields are Snap, a first line holding only a number is DenseMatrix
+// and anything else is Text
+inline GraphFileFormat DetectGraphFormat(const std::string& file_name);
+
+// Desc: Parses a METIS .graph file
+// Pre: [begin, end) must hold the file named file_name
+// Post: The edges are appended with ids 1 to n and n + 1 is returned. Vertex
+// sizes and weights are skipped, edge weights are kept when the format
+// field has them. Throws FormatErr if the header or an id is invalid
+template <typename T>
+long ParseMetisGraph(const char* begin, const char* end, std::vector<std::pair<std::pair<long, long>, T>>& edges, const std::string& file_name);
+
+// Desc: Parses a Matrix Market coordinate file
+// Pre: [begin, end) must hold the file named file_name
+// Post: The edges are appended with the file's 1 based ids and
+// max(rows, columns) + 1 is returned.
+// Pattern entries get weight 1, values are truncated to T with positive
+// values below 1 kept as 1, entries that are not positive are dropped.
+// Throws FormatErr if the banner, size line or an id is invalid
+template <typename T>
+long ParseMatrixMarket(const char* begin, const char* end, std::vector<std::pair<std::pair<long, long>, T>>& edges, const std::string& file_name);
+
+// Desc: Parses a SNAP edge list
+// Pre: [begin, end) must hold the file named file_name
+// Post: The edges are appended with weight 1 and the highest id + 1 is
+// returned. Throws FormatErr if an id is negative
+template <typename T>
+long ParseSnapEdgeList(const char* begin, const char* end, std::vector<std::pair<std::pair<long, long>, T>>& edges, const std::string& file_name);
+
+#include "GraphFormats.hpp"
@@ -0,0 +1,173 @@
+#include <fstream>
+#include <algorithm>
+#include <cctype>
+
+// case insensitive prefix test used for the Matrix Market banner
+inline bool StartsWithNoCase(const char* pos, const char* end, const std::string& prefix)
+{
+  if (static_cast<std::size_t>(end - pos) < prefix.size())
+    return false;
+  for (std::size_t i = 0; i < prefix.size(); i++)
+    if (std::tolower(static_cast<unsigned char>(pos[i])) != std::tolower(static_cast<unsigned char>(prefix[i])))
+      return false;
+  return true;
+}
+
+inline GraphFileFormat DetectGraphFormat(const std::string& file_name)
+{
+  if (IsGraphSnapshot(file_name))
+    return GraphFileFormat::Snapshot;
+
+  std::ifstream is(file_name.c_str());
+  std::string line;
+  std::getline(is, line);
+  if (StartsWithNoCase(line.data(), line.data() + line.size(), "%%MatrixMarket"))
+    return GraphFileFormat::MatrixMarket;
+
+  auto dot = file_name.find_last_of('.');
+  std::string extension = (dot == std::string::npos ? "" : file_name.substr(dot));
+  std::transform(extension.begin(), extension.end(), extension.begin(), ::tolower);
+  if (extension == ".mtx")
+    return GraphFileFormat::MatrixMarket;
+  if (extension == ".graph" || extension == ".metis")
+    return GraphFileFormat::Metis;
+
+  if (!line.empty() && line[0] == '#')
+    return GraphFileFormat::Snap;
+  long fields = 0;
+  long value = 0;
+  const char* pos = line.data();
+  while (ScanLongToken(pos, line.data() + line.size(), value))
+    fields++;
+  if (fields == 1 && line.find_first_not_of("0123456789 \t\r") == std::string::npos)
+    return GraphFileFormat::DenseMatrix;
+  return (fields == 2 ? GraphFileFormat::Snap : GraphFileFormat::Text);
+}
+
+template <typename T>
+long ParseMetisGraph(const char* begin, const char* end, std::vector<std::pair<std::pair<long, long>, T>>& edges, const std::string& file_name)
+{
+  // the header is the first line that is not a '%' comment
+  const char* line = begin;
+  while (line < end && *line == '%')
+    line = LineEnd(line, end) + 1;
+  if (line >= end)
+    throw FormatErr(file_name);
+
+  auto eol = LineEnd(line, end);
+  long node_count = 0;
+  long edge_count = 0;
+  long format = 0;
+  long constraints = 1;
+  if (!ScanLongToken(line, eol, node_count) || !ScanLongToken(line, eol, edge_count) || node_count < 0 || edge_count < 0)
+    throw FormatErr(file_name);
+  ScanLongToken(line, eol, format);
+  ScanLongToken(line, eol, constraints);
+  const bool has_sizes = (format / 100 % 10 != 0);
+  const bool has_vertex_weights = (format / 10 % 10 != 0);
+  const bool has_edge_weights = (format % 10 != 0);
+  edges.reserve(edges.size() + 2 * edge_count);
+
+  // line i holds the neighbors of node i, blank lines are nodes without any
+  line = eol + 1;
+  for (long node = 1; node <= node_count && line < end; line = eol + 1)
+  {
+    eol = LineEnd(line, end);
+    if (line < eol && *line == '%')
+      continue;
+
+    long value = 0;
+    if (has_sizes)
+      ScanLongToken(line, eol, value);
+    if (has_vertex_weights)
+      for (long i = 0; i < constraints; i++)
+        ScanLongToken(line, eol, value);
+
+    long neighbor = 0;
+    while (ScanLongToken(line, eol, neighbor))
+    {
+      long weight = 1;
+      if (has_edge_weights && !ScanLongToken(line, eol, weight))
+        throw FormatErr(file_name);
+      if (neighbor < 1 || neighbor > node_count)
+        throw FormatErr(file_name);
+      if (weight > 0)
+        edges.push_back(std::make_pair(std::make_pair(std::min(node, neighbor), std::max(node, neighbor)), static_cast<T>(weight)));
+    }
+    node++;
+  }
+  return node_count + 1;
+}
+
+template <typename T>
+long ParseMatrixMarket(const char* begin, const char* end, std::vector<std::pair<std::pair<long, long>, T>>& edges, const std::string& file_name)
+{
+  // %%MatrixMarket matrix coordinate <field> <symmetry>
+  const char* line = begin;
+  auto eol = LineEnd(line, end);
+  if (!StartsWithNoCase(line, eol, "%%MatrixMarket"))
+    throw FormatErr(file_name);
+  std::string banner(line, eol);
+  std::transform(banner.begin(), banner.end(), banner.begin(), ::tolower);
+  if (banner.find(" coordinate") == std::string::npos || banner.find(" complex") != std::string::npos)
+    throw FormatErr(file_name);
+  const bool pattern = (banner.find(" pattern") != std::string::npos);
+
+  // the size line is the first line after the banner that is not a comment
+  line = eol + 1;
+  while (line < end && (*line == '%' || *line == '\n'))
+    line = LineEnd(line, end) + 1;
+  if (line >= end)
+    throw FormatErr(file_name);
+  eol = LineEnd(line, end);
+  long rows = 0;
+  long columns = 0;
+  long entries = 0;
+  if (!ScanLongToken(line, eol, rows) || !ScanLongToken(line, eol, columns) || !ScanLongToken(line, eol, entries) || entries < 0)
+    throw FormatErr(file_name);
+  const long node_count = std::max(rows, columns);
+  edges.reserve(edges.size() + entries);
+
+  for (line = eol + 1; line < end; line = eol + 1)
+  {
+    eol = LineEnd(line, end);
+    long row = 0;
+    long column = 0;
+    if (*line == '%' || !ScanLongToken(line, eol, row))
+      continue;
+    if (!ScanLongToken(line, eol, column) || row < 1 || row > node_count || column < 1 || column > node_count)
+      throw FormatErr(file_name);
+
+    T weight(1);
+    double value = 1;
+    if (!pattern && ScanDoubleToken(line, eol, value))
+    {
+      if (value <= 0)
+        continue;
+      weight = std::max(static_cast<T>(value), T(1));
+    }
+    edges.push_back(std::make_pair(std::make_pair(std::min(row, column), std::max(row, column)), weight));
+  }
+  return node_count + 1;
+}
+
+template <typename T>
+long ParseSnapEdgeList(const char* begin, const char* end, std::vector<std::pair<std::pair<long, long>, T>>& edges, const std::string& file_name)
+{
+  long max_id = -1;
+  const char* eol = begin;
+  for (const char* line = begin; line < end; line = eol + 1)
+  {
+    eol = LineEnd(line, end);
+    long a = 0;
+    long b = 0;
+    if (*line == '#' || !ScanLongToken(line, eol, a) || !ScanLongToken(line, eol, b))
+      continue;
+    if (a < 0 || b < 0)
+      throw FormatErr(file_name);
+
+    edges.push_back(std::make_pair(std::make_pair(std::min(a, b), std::max(a, b)), T(1)));
+    max_id = std::max(max_id, std::max(a, b));
+  }
+  return max_id + 1;
+}
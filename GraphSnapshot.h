@@ -0,0 +1,39 @@
+#pragma once
+#include "UndirectedGraph.h"
+#include <cstdint>
+#include <string>
+
+// Binary graph snapshots hold a graph in CSR form so MappedAdjacency
+// can use a memory mapping of the file as is. The layout, in native
+// byte order, is
+//   SnapshotHeader
+//   int64_t offsets[node_count + 1]   row i is entries offsets[i] .. offsets[i + 1] - 1
+//   int64_t neighbors[entry_count]    the sorted neighbors of each row
+//   T       weights[entry_count]      only if weight_size != 0
+// Degrees are the differences of consecutive offsets
+const char SNAPSHOT_MAGIC[8] = { 'H', 'P', 'G', 'R', 'A', 'P', 'H', '\0' };
+const uint32_t SNAPSHOT_VERSION = 1;
+
+struct SnapshotHeader
+{
+  char magic[8];
+  uint32_t version;
+  // bytes per edge weight, 0 if the snapshot holds no weights
+  uint32_t weight_size;
+  int64_t node_count;
+  int64_t entry_count;
+};
+
+// Desc: Writes a graph to a binary snapshot
+// Pre: The graph must not be modified while it is written
+// Post: The snapshot is written to file_name, with the edge weights as T if
+// weighted is true. Throws FileErr if the file cannot be written
+template <typename T, typename Graph>
+void WriteGraphSnapshot(const std::string& file_name, const Graph& graph, const bool weighted);
+
+// Desc: Checks whether a file starts with a snapshot header
+// Pre: None
+// Post: Returns true if the first bytes of the file are SNAPSHOT_MAGIC
+inline bool IsGraphSnapshot(const std::string& file_name);
+
+#include "GraphSnapshot.hpp"
@@ -0,0 +1,59 @@
+#include <fstream>
+#include <cstring>
+#include <vector>
+
+template <typename T, typename Graph>
+void WriteGraphSnapshot(const std::string& file_name, const Graph& graph, const bool weighted)
+{
+  std::ofstream os(file_name.c_str(), std::ios::binary | std::ios::trunc);
+  if (!os.is_open())
+    throw FileErr(file_name);
+
+  const long size = graph.GetSize();
+  std::vector<int64_t> offsets(size + 1, 0);
+  for (long i = 0; i < size; i++)
+    offsets[i + 1] = offsets[i] + graph.GetDegree(i);
+
+  SnapshotHeader header;
+  std::memcpy(header.magic, SNAPSHOT_MAGIC, sizeof(header.magic));
+  header.version = SNAPSHOT_VERSION;
+  header.weight_size = (weighted ? sizeof(T) : 0);
+  header.node_count = size;
+  header.entry_count = offsets[size];
+  os.write(reinterpret_cast<const char*>(&header), sizeof(header));
+  os.write(reinterpret_cast<const char*>(offsets.data()), offsets.size() * sizeof(int64_t));
+
+  // one row at a time so only a single row is ever copied
+  std::vector<int64_t> row;
+  for (long i = 0; i < size; i++)
+  {
+    auto neighbors = graph.Neighbors(i);
+    row.assign(neighbors.begin(), neighbors.end());
+    os.write(reinterpret_cast<const char*>(row.data()), row.size() * sizeof(int64_t));
+  }
+
+  if (weighted)
+  {
+    std::vector<T> weights;
+    for (long i = 0; i < size; i++)
+    {
+      weights.clear();
+      graph.ForEachNeighbor(i, [&](const long, const double weight)
+      {
+        weights.push_back(static_cast<T>(weight));
+      });
+      os.write(reinterpret_cast<const char*>(weights.data()), weights.size() * sizeof(T));
+    }
+  }
+
+  if (!os.good())
+    throw FileErr(file_name);
+}
+
+inline bool IsGraphSnapshot(const std::string& file_name)
+{
+  std::ifstream is(file_name.c_str(), std::ios::binary);
+  char magic[sizeof(SNAPSHOT_MAGIC)] = {};
+  is.read(magic, sizeof(magic));
+  return (is.gcount() == sizeof(magic) && std::memcmp(magic, SNAPSHOT_MAGIC, sizeof(magic)) == 0);
+}
@@ -0,0 +1,82 @@
+#pragma once
+#include <vector>
+#include <memory>
+#include <algorithm>
+#include "Exceptions.h"
+#include "NeighborRange.h"
+#include "MappedFile.h"
+#include "GraphSnapshot.h"
+
+// Read-only CSR adjacency that lives inside a memory mapped graph
+// snapshot (see GraphSnapshot.h). Opening only checks the header, the
+// rows are read straight out of the mapping, so loading is O(1) and
+// processes mapping the same snapshot share its pages. The rows are
+// trusted unless Open is asked to verify them, a snapshot corrupted
+// past its header can otherwise cause reads outside the mapping
+template <typename T>
+class MappedAdjacency
+{
+  public:
+    // Desc: Instantiates an adjacency with no nodes and no file
+    // Pre: None
+    // Post: An empty adjacency will be created
+    MappedAdjacency();
+
+    // Desc: Maps a graph snapshot
+    // Pre: None
+    // Post: The adjacency will view the snapshot's rows, throws FileErr if
+    // the file cannot be mapped and FormatErr if it is not a snapshot of
+    // this version and weight type. With verify the offsets and neighbor
+    // ids are also checked in O(n + m), so that every row lies inside
+    // the mapping and holds sorted ids of existing nodes
+    void Open(const std::string& file_name, const bool verify = false);
+
+    // Desc: Returns the number of nodes
+    // Pre: None
+    // Post: The number of nodes is returned
+    inline long GetSize() const { return node_count; }
+    // Desc: Returns whether the snapshot holds edge weights
+    // Pre: None
+    // Post: Returns true if weights are stored
+    inline bool HasWeights() const { return weights != nullptr; }
+
+    // Desc: Returns the number of neighbors of a node
+    // Pre: idx must be between 0 and the size - 1
+    // Post: The degree of the node is returned in O(1)
+    long GetDegree(const long idx) const;
+    // Desc: Returns the neighbors of a node
+    // Pre: idx must be between 0 and the size - 1
+    // Post: The sorted neighbor ids are copied into a new vector
+    std::vector<long> GetNeighbors(const long idx) const;
+    // Desc: Returns a view of the neighbors of a node
+    // Pre: idx must be between 0 and the size - 1
+    // Post: A range over the mapped row is returned without copying
+    NeighborRange Neighbors(const long idx) const;
+    // Desc: Returns the edge weights of a node's neighbors
+    // Pre: idx must be between 0 and the size - 1
+    // Post: A pointer to GetDegree(idx) weights is returned, in the same
+    // order as Neighbors(idx), or nullptr if weights are not stored
+    const T* NeighborWeights(const long idx) const;
+    // Desc: Checks whether an edge is stored
+    // Pre: node_a and node_b must be between 0 and the size - 1
+    // Post: Returns true if the edge exists, found by binary search
+    bool HasEdge(const long node_a, const long node_b) const;
+    // Desc: Returns the weight of an edge
+    // Pre: node_a and node_b must be between 0 and the size - 1
+    // Post: Returns the stored weight, or 1 if weights are not stored,
+    // if the edge exists, otherwise 0
+    T GetEdgeWeight(const long node_a, const long node_b) const;
+
+  protected:
+    void CheckIndex(const long idx) const;
+
+    // shared so copies of a graph keep the mapping alive
+    std::shared_ptr<MappedFile> file;
+    long node_count;
+    // pointers into the mapping, laid out as in GraphSnapshot.h
+    const long* offsets;
+    const long* neighbors;
+    const T* weights;
+};
+
+#include "MappedAdjacency.hpp"
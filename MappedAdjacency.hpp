@@ -0,0 +1,112 @@
+template <typename T>
+MappedAdjacency<T>::MappedAdjacency()
+: file(), node_count(0), offsets(nullptr), neighbors(nullptr), weights(nullptr)
+{
+}
+
+template <typename T>
+void MappedAdjacency<T>::Open(const std::string& file_name, const bool verify)
+{
+  // the rows are used in place as longs
+  static_assert(sizeof(long) == sizeof(int64_t), "snapshots need a 64 bit long");
+
+  // the rows are followed in search order, unless every row is about
+  // to be read front to back by the verification below
+  auto mapping = std::make_shared<MappedFile>(file_name, (verify ? FileAccess::Normal : FileAccess::Random));
+  if (mapping->size() < sizeof(SnapshotHeader))
+    throw FormatErr(file_name);
+
+  SnapshotHeader header;
+  std::memcpy(&header, mapping->begin(), sizeof(header));
+  if (std::memcmp(header.magic, SNAPSHOT_MAGIC, sizeof(header.magic)) != 0 || header.version != SNAPSHOT_VERSION)
+    throw FormatErr(file_name);
+  if (header.weight_size != 0 && header.weight_size != sizeof(T))
+    throw FormatErr(file_name);
+  // bounding the counts by the file size first keeps the sum below from overflowing
+  const int64_t max_count = static_cast<int64_t>(mapping->size() / sizeof(int64_t));
+  if (header.node_count < 0 || header.entry_count < 0 || header.node_count >= max_count || header.entry_count > max_count)
+    throw FormatErr(file_name);
+
+  const std::size_t expected = sizeof(SnapshotHeader) + (header.node_count + 1) * sizeof(int64_t)
+    + header.entry_count * (sizeof(int64_t) + header.weight_size);
+  if (mapping->size() < expected)
+    throw FormatErr(file_name);
+
+  auto rows = reinterpret_cast<const long*>(mapping->begin() + sizeof(SnapshotHeader));
+  if (rows[0] != 0 || rows[header.node_count] != header.entry_count)
+    throw FormatErr(file_name);
+  if (verify)
+  {
+    auto ids = rows + header.node_count + 1;
+    for (long i = 0; i < header.node_count; i++)
+    {
+      if (rows[i + 1] < rows[i])
+        throw FormatErr(file_name);
+      for (long j = rows[i]; j < rows[i + 1]; j++)
+        if (ids[j] < 0 || ids[j] >= header.node_count || (j > rows[i] && ids[j] <= ids[j - 1]))
+          throw FormatErr(file_name);
+    }
+  }
+
+  file = mapping;
+  node_count = header.node_count;
+  offsets = rows;
+  neighbors = offsets + node_count + 1;
+  weights = (header.weight_size != 0 ? reinterpret_cast<const T*>(neighbors + header.entry_count) : nullptr);
+}
+
+template <typename T>
+long MappedAdjacency<T>::GetDegree(const long idx) const
+{
+  CheckIndex(idx);
+  return offsets[idx + 1] - offsets[idx];
+}
+
+template <typename T>
+std::vector<long> MappedAdjacency<T>::GetNeighbors(const long idx) const
+{
+  CheckIndex(idx);
+  return std::vector<long>(neighbors + offsets[idx], neighbors + offsets[idx + 1]);
+}
+
+template <typename T>
+NeighborRange MappedAdjacency<T>::Neighbors(const long idx) const
+{
+  CheckIndex(idx);
+  return NeighborRange(neighbors + offsets[idx], neighbors + offsets[idx + 1]);
+}
+
+template <typename T>
+const T* MappedAdjacency<T>::NeighborWeights(const long idx) const
+{
+  CheckIndex(idx);
+  return (weights != nullptr ? weights + offsets[idx] : nullptr);
+}
+
+template <typename T>
+bool MappedAdjacency<T>::HasEdge(const long node_a, const long node_b) const
+{
+  CheckIndex(node_a);
+  CheckIndex(node_b);
+  return std::binary_search(neighbors + offsets[node_a], neighbors + offsets[node_a + 1], node_b);
+}
+
+template <typename T>
+T MappedAdjacency<T>::GetEdgeWeight(const long node_a, const long node_b) const
+{
+  CheckIndex(node_a);
+  CheckIndex(node_b);
+  auto first = neighbors + offsets[node_a];
+  auto last = neighbors + offsets[node_a + 1];
+  auto itr = std::lower_bound(first, last, node_b);
+  if (itr == last || *itr != node_b)
+    return T(0);
+  return (weights != nullptr ? weights[itr - neighbors] : T(1));
+}
+
+template <typename T>
+void MappedAdjacency<T>::CheckIndex(const long idx) const
+{
+  if (idx < 0 || idx >= node_count)
+    throw SubscriptErr(idx);
+}
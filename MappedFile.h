@@ -0,0 +1,39 @@
+#pragma once
+#include <string>
+#include <cstddef>
+#include "Exceptions.h"
+
+// How a mapping will be read, passed on to the kernel as a readahead hint.
+// Sequential suits parsing a file front to back, Random suits following
+// rows in whatever order a search visits them, Normal keeps the default
+enum class FileAccess { Sequential, Random, Normal };
+
+// Read-only memory mapping of a whole file. The pages are faulted in
+// by the kernel as they are read, so large files are parsed in place
+// without being copied into stream buffers
+class MappedFile
+{
+  public:
+    // Desc: Maps the named file into memory
+    // Pre: None
+    // Post: The file contents are readable through begin() and end(),
+    // with access as the readahead hint. Throws FileErr if the file
+    // cannot be opened or mapped
+    MappedFile(const std::string& file_name, const FileAccess access = FileAccess::Sequential);
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    // Desc: Unmaps the file
+    // Pre: None
+    // Post: Pointers into the file are no longer valid
+    ~MappedFile();
+
+    inline const char* begin() const { return data; }
+    inline const char* end() const { return data + length; }
+    inline std::size_t size() const { return length; }
+
+  private:
+    const char* data;
+    std::size_t length;
+};
+
+#include "MappedFile.hpp"
@@ -0,0 +1,44 @@
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+MappedFile::MappedFile(const std::string& file_name, const FileAccess access)
+: data(nullptr), length(0)
+{
+  int fd = open(file_name.c_str(), O_RDONLY);
+  if (fd < 0)
+    throw FileErr(file_name);
+
+  struct stat info;
+  if (fstat(fd, &info) != 0)
+  {
+    close(fd);
+    throw FileErr(file_name);
+  }
+
+  // an empty file cannot be mapped, it is left as an empty range
+  length = static_cast<std::size_t>(info.st_size);
+  if (length > 0)
+  {
+    void* address = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (address == MAP_FAILED)
+    {
+      close(fd);
+      throw FileErr(file_name);
+    }
+    if (access == FileAccess::Sequential)
+      madvise(address, length, MADV_SEQUENTIAL);
+    else if (access == FileAccess::Random)
+      madvise(address, length, MADV_RANDOM);
+    data = static_cast<const char*>(address);
+  }
+  // the mapping stays valid after the descriptor is closed
+  close(fd);
+}
+
+MappedFile::~MappedFile()
+{
+  if (data != nullptr)
+    munmap(const_cast<char*>(data), length);
+}
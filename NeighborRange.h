@@ -0,0 +1,134 @@
+#pragma once
+#include <cstdint>
+#include <iterator>
+
+// Read-only view of one node's neighbor ids inside a graph's storage.
+// It neither owns nor copies the ids, so it is only valid until the
+// graph it came from is modified or destroyed. The ids are either a
+// run of longs (neighbor lists, CSR rows), the set bits of a
+// bit-packed adjacency row, or a gap and varint coded row
+class NeighborRange
+{
+  public:
+    class const_iterator
+    {
+      public:
+        typedef std::forward_iterator_tag iterator_category;
+        typedef long value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef const long* pointer;
+        typedef long reference;
+
+        const_iterator() : kind(List), ids(nullptr), words(nullptr), bytes(nullptr), current(0), limit(0) {}
+        const_iterator(const long* pos) : kind(List), ids(pos), words(nullptr), bytes(nullptr), current(0), limit(0) {}
+        const_iterator(const uint64_t* row, const long pos, const long end)
+        : kind(Bits), ids(nullptr), words(row), bytes(nullptr), current(NextSetBit(row, pos, end)), limit(end) {}
+        const_iterator(const uint8_t* row, const long count, const long node)
+        : kind(Varint), ids(nullptr), words(nullptr), bytes(row), current(0), limit(count)
+        {
+          // the first id is stored as a zigzag coded offset from the node itself
+          if (limit > 0)
+          {
+            uint64_t first = ReadVarint(bytes);
+            current = node + static_cast<long>((first >> 1) ^ (~(first & 1) + 1));
+          }
+        }
+
+        inline long operator*() const { return (kind == List ? *ids : current); }
+        inline const_iterator& operator++()
+        {
+          if (kind == List)
+            ++ids;
+          else if (kind == Bits)
+            current = NextSetBit(words, current + 1, limit);
+          else if (--limit > 0)
+            current += static_cast<long>(ReadVarint(bytes));
+          return *this;
+        }
+        inline const_iterator operator++(int) { const_iterator tmp = *this; ++(*this); return tmp; }
+        inline bool operator==(const const_iterator& rhs) const
+        {
+          if (kind == List)
+            return ids == rhs.ids;
+          if (kind == Bits)
+            return current == rhs.current;
+          return limit == rhs.limit;
+        }
+        inline bool operator!=(const const_iterator& rhs) const { return !(*this == rhs); }
+
+        // Desc: Finds the first set bit at or after pos
+        // Pre: row must hold at least end bits
+        // Post: The index of the bit is returned, or end if there is none
+        static inline long NextSetBit(const uint64_t* row, long pos, const long end)
+        {
+          while (pos < end)
+          {
+            uint64_t word = row[pos >> 6] >> (pos & 63);
+            if (word != 0)
+            {
+              pos += __builtin_ctzll(word);
+              return (pos < end ? pos : end);
+            }
+            pos = (pos | 63) + 1;
+          }
+          return end;
+        }
+
+        // Desc: Decodes one LEB128 variable length integer
+        // Pre: pos must point at the first byte of a varint
+        // Post: The value is returned and pos is moved past it
+        static inline uint64_t ReadVarint(const uint8_t*& pos)
+        {
+          uint64_t value = 0;
+          int shift = 0;
+          while (*pos & 0x80)
+          {
+            value |= static_cast<uint64_t>(*pos++ & 0x7f) << shift;
+            shift += 7;
+          }
+          value |= static_cast<uint64_t>(*pos++) << shift;
+          return value;
+        }
+
+      private:
+        enum Kind { List, Bits, Varint };
+
+        Kind kind;
+        // List: the current id
+        const long* ids;
+        // Bits: the row, current is the set bit and limit the row length
+        const uint64_t* words;
+        // Varint: the next gap, current is the decoded id and limit
+        // the number of ids left including it
+        const uint8_t* bytes;
+        long current;
+        long limit;
+    };
+
+    // Desc: Creates an empty range
+    // Pre: None
+    // Post: begin() == end()
+    NeighborRange() : first(), last() {}
+    // Desc: Creates a range over the ids in [begin, end)
+    // Pre: begin and end must point into the same array
+    // Post: The range will view the ids without copying them
+    NeighborRange(const long* begin, const long* end) : first(begin), last(end) {}
+    // Desc: Creates a range over the set bits of a bit row
+    // Pre: row must hold at least bits bits
+    // Post: The range will yield the index of every set bit, in order
+    NeighborRange(const uint64_t* row, const long bits) : first(row, 0, bits), last(row, bits, bits) {}
+    // Desc: Creates a range over a compressed row of count ids
+    // Pre: row must point at the zigzag coded first id of node's row
+    // Post: The range will decode the ids one at a time, in order
+    NeighborRange(const uint8_t* row, const long count, const long node) : first(row, count, node), last(row, 0, node) {}
+
+    inline const_iterator begin() const { return first; }
+    inline const_iterator end() const { return last; }
+    inline bool empty() const { return first == last; }
+    inline long size() const { return static_cast<long>(std::distance(first, last)); }
+    inline long operator[](const long i) const { return *std::next(first, i); }
+
+  private:
+    const_iterator first;
+    const_iterator last;
+};
@@ -0,0 +1,35 @@
+#pragma once
+#include "UndirectedGraph.h"
+#include <vector>
+
+// Node orderings that improve the memory locality of traversals.
+// Each function returns order, where order[k] is the id of the node
+// that should be placed at position k. InvertOrdering turns that into
+// the new_ids argument of UndirectedUnlabeledGraph::Relabel
+
+// Desc: Orders the nodes breadth first, one component after another
+// Pre: None
+// Post: Neighbors get nearby positions, components start at their lowest id
+template <typename T>
+std::vector<long> BreadthFirstOrdering(const UndirectedGraph<T>& graph);
+
+// Desc: Orders the nodes by reverse Cuthill-McKee
+// Pre: None
+// Post: Each component is searched breadth first from a node of
+// minimum degree, visiting neighbors by increasing degree, and the
+// whole sequence is reversed, which keeps the adjacency bandwidth low
+template <typename T>
+std::vector<long> ReverseCuthillMcKeeOrdering(const UndirectedGraph<T>& graph);
+
+// Desc: Orders the nodes by decreasing degree
+// Pre: None
+// Post: The hub nodes, which are visited most, are packed together
+template <typename T>
+std::vector<long> DegreeOrdering(const UndirectedGraph<T>& graph);
+
+// Desc: Inverts an ordering
+// Pre: order must be a permutation of 0 .. order.size() - 1
+// Post: new_ids[order[k]] == k is returned
+inline std::vector<long> InvertOrdering(const std::vector<long>& order);
+
+#include "NodeOrdering.hpp"
@@ -0,0 +1,93 @@
+template <typename T>
+std::vector<long> BreadthFirstOrdering(const UndirectedGraph<T>& graph)
+{
+  const long size = graph.GetSize();
+  std::vector<long> order;
+  order.reserve(size);
+  std::vector<bool> visited(size, false);
+
+  for (long start = 0; start < size; start++)
+  {
+    if (visited[start])
+      continue;
+
+    // the order vector doubles as the queue
+    visited[start] = true;
+    auto head = order.size();
+    order.push_back(start);
+    while (head < order.size())
+    {
+      auto node = order[head++];
+      for (const auto n : graph.Neighbors(node))
+      {
+        if (!visited[n])
+        {
+          visited[n] = true;
+          order.push_back(n);
+        }
+      }
+    }
+  }
+  return order;
+}
+
+template <typename T>
+std::vector<long> ReverseCuthillMcKeeOrdering(const UndirectedGraph<T>& graph)
+{
+  const long size = graph.GetSize();
+  std::vector<long> order;
+  order.reserve(size);
+  std::vector<bool> visited(size, false);
+  std::vector<long> degrees(size);
+  for (long i = 0; i < size; i++)
+    degrees[i] = graph.GetDegree(i);
+  auto by_degree = [&degrees](const long a, const long b)
+  {
+    return (degrees[a] != degrees[b] ? degrees[a] < degrees[b] : a < b);
+  };
+
+  // walking the nodes by increasing degree starts every
+  // component at one of its minimum degree nodes
+  std::vector<long> children;
+  for (const auto start : graph.GetNodesByDegree(false))
+  {
+    if (visited[start])
+      continue;
+
+    visited[start] = true;
+    auto head = order.size();
+    order.push_back(start);
+    while (head < order.size())
+    {
+      auto node = order[head++];
+      children.clear();
+      for (const auto n : graph.Neighbors(node))
+      {
+        if (!visited[n])
+        {
+          visited[n] = true;
+          children.push_back(n);
+        }
+      }
+      std::sort(children.begin(), children.end(), by_degree);
+      order.insert(order.end(), children.begin(), children.end());
+    }
+  }
+
+  std::reverse(order.begin(), order.end());
+  return order;
+}
+
+template <typename T>
+std::vector<long> DegreeOrdering(const UndirectedGraph<T>& graph)
+{
+  return graph.GetNodesByDegree(true);
+}
+
+inline std::vector<long> InvertOrdering(const std::vector<long>& order)
+{
+  std::vector<long> new_ids(order.size());
+  for (long k = 0; k < static_cast<long>(order.size()); k++)
+    new_ids[order[k]] = k;
+  return new_ids;
+}
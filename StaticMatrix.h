@@ -0,0 +1,96 @@
+#pragma once
+#include "Vector.h"
+
+// Compile time (CRTP) counterpart of the Matrix interface.
+// Derived must provide Dimension(), Get(row, col) and Set(row, col, val)
+// as non-virtual members and a Derived(size) constructor. Every element
+// access below then resolves statically and can be inlined, while the
+// virtual Matrix<T> operators of Derived can forward to these.
+// Derived also provides a static constexpr bool Symmetric, true if
+// (row, col) and (col, row) are one stored element. Element wise
+// algorithms then only visit the upper triangle, col >= row
+template <typename Derived, typename T>
+class StaticMatrix
+{
+  public:
+    // Desc: Returns the calling object as its concrete type
+    // Pre: None
+    // Post: A reference to the derived matrix is returned
+    inline const Derived& Self() const { return static_cast<const Derived&>(*this); }
+    inline Derived& Self() { return static_cast<Derived&>(*this); }
+
+    // Desc: Checks for diagonal dominance of the matrix
+    // Pre: The type T must have abs defined for it
+    // Post: Returns a boolean for diagonal dominance
+    bool DiagonallyDominant() const;
+    // Desc: Creates a new matrix with the values of the calling object
+    // multiplied by the rhs parameter
+    // Pre: The type T must have * defined for it
+    // Post: A new matrix of the derived type is returned
+    Derived MultiplyScalar(const T rhs) const;
+    // Desc: Creates a new vector with the values of the calling object
+    // multiplied by the rhs vector
+    // Pre: The rhs parameter must be of same size as object
+    // Post: A new vector will be returned that contains the product
+    Vector<T> MultiplyVector(const Vector<T>& rhs) const;
+    // Desc: Creates a new matrix with the values of the calling object
+    // multiplied by the rhs matrix
+    // Pre: The rhs parameter must be of same size as object
+    // Post: A new matrix of the derived type is returned
+    template <typename Other>
+    Derived MultiplyMatrix(const StaticMatrix<Other, T>& rhs) const;
+    // Desc: Creates a new matrix with the values of the calling object
+    // plus the rhs parameter
+    // Pre: The type T must have + defined for it
+    // Post: A new matrix of the derived type is returned
+    Derived AddScalar(const T rhs) const;
+    // Desc: Creates a new matrix with the values of the calling object
+    // plus the rhs matrix
+    // Pre: The rhs parameter must be of same size as object
+    // Post: A new matrix of the derived type is returned
+    template <typename Other>
+    Derived AddMatrix(const StaticMatrix<Other, T>& rhs) const;
+    // Desc: Creates a new matrix with the values of the calling object
+    // minus the rhs parameter
+    // Pre: The type T must have - defined for it
+    // Post: A new matrix of the derived type is returned
+    Derived SubtractScalar(const T rhs) const;
+    // Desc: Creates a new matrix with the values of the calling object
+    // minus the rhs matrix
+    // Pre: The rhs parameter must be of same size as object
+    // Post: A new matrix of the derived type is returned
+    template <typename Other>
+    Derived SubtractMatrix(const StaticMatrix<Other, T>& rhs) const;
+
+    // Desc: Adds the parameter type to itself
+    // Pre: The type T must have + defined for it
+    // Post: Each value of the matrix will have rhs added to it
+    Derived& AddScalarInPlace(const T rhs);
+    // Desc: Adds the parameter matrix to itself
+    // Pre: The rhs parameter must be of same size as object
+    // Post: Each value of the matrix will have the matching value of rhs added to it
+    template <typename Other>
+    Derived& AddMatrixInPlace(const StaticMatrix<Other, T>& rhs);
+    // Desc: Subtracts the parameter type from itself
+    // Pre: The type T must have - defined for it
+    // Post: Each value of the matrix will have rhs subtracted from it
+    Derived& SubtractScalarInPlace(const T rhs);
+    // Desc: Subtracts the parameter matrix from itself
+    // Pre: The rhs parameter must be of same size as object
+    // Post: Each value of the matrix will have the matching value of rhs subtracted from it
+    template <typename Other>
+    Derived& SubtractMatrixInPlace(const StaticMatrix<Other, T>& rhs);
+    // Desc: Transposes the matrix
+    // Pre: None
+    // Post: Transforms the object into the transpose of itself,
+    // which leaves a symmetric matrix as it is
+    Derived& TransposeInPlace();
+
+  protected:
+    // Desc: Returns the first column an element wise pass visits in a row
+    // Pre: None
+    // Post: row is returned for symmetric matrices, otherwise 0
+    inline long FirstColumn(const long row) const { return (Derived::Symmetric ? row : 0); }
+};
+
+#include "StaticMatrix.hpp"
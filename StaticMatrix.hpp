@@ -0,0 +1,187 @@
+template <typename Derived, typename T>
+bool StaticMatrix<Derived, T>::DiagonallyDominant() const
+{
+  const long size = Self().Dimension();
+  for (long i = 0; i < size; i++)
+  {
+    T sum = 0;
+    for (long j = 0; j < size; j++)
+    {
+      if (i != j)
+        sum += abs(Self().Get(i, j));
+    }
+    if (sum > abs(Self().Get(i, i)))
+      return false;
+  }
+  return true;
+}
+
+template <typename Derived, typename T>
+Derived StaticMatrix<Derived, T>::MultiplyScalar(const T rhs) const
+{
+  const long size = Self().Dimension();
+  Derived m(size);
+  for (long i = 0; i < size; i++)
+    for (long j = FirstColumn(i); j < size; j++)
+      m.Set(i, j, Self().Get(i, j) * rhs);
+  return m;
+}
+
+template <typename Derived, typename T>
+Vector<T> StaticMatrix<Derived, T>::MultiplyVector(const Vector<T>& rhs) const
+{
+  const long size = Self().Dimension();
+  if (rhs.GetSize() != size)
+    throw SizeErr(size, rhs.GetSize());
+
+  Vector<T> vect(size);
+  for (long i = 0; i < size; i++)
+  {
+    T sum = 0;
+    for (long j = 0; j < size; j++)
+      sum += (Self().Get(i, j) * rhs.Get(j));
+    vect.Get(i) = sum;
+  }
+  return vect;
+}
+
+template <typename Derived, typename T>
+template <typename Other>
+Derived StaticMatrix<Derived, T>::MultiplyMatrix(const StaticMatrix<Other, T>& rhs) const
+{
+  const long size = Self().Dimension();
+  if (rhs.Self().Dimension() != size)
+    throw SizeErr(size, rhs.Self().Dimension());
+
+  Derived m(size);
+  for (long i = 0; i < size; i++)
+  {
+    for (long j = 0; j < size; j++)
+    {
+      T sum = 0;
+      for (long k = 0; k < size; k++)
+        sum += (Self().Get(i, k) * rhs.Self().Get(k, j));
+      m.Set(i, j, sum);
+    }
+  }
+  return m;
+}
+
+template <typename Derived, typename T>
+Derived StaticMatrix<Derived, T>::AddScalar(const T rhs) const
+{
+  const long size = Self().Dimension();
+  Derived m(size);
+  for (long i = 0; i < size; i++)
+    for (long j = FirstColumn(i); j < size; j++)
+      m.Set(i, j, Self().Get(i, j) + rhs);
+  return m;
+}
+
+template <typename Derived, typename T>
+template <typename Other>
+Derived StaticMatrix<Derived, T>::AddMatrix(const StaticMatrix<Other, T>& rhs) const
+{
+  const long size = Self().Dimension();
+  if (rhs.Self().Dimension() != size)
+    throw SizeErr(size, rhs.Self().Dimension());
+
+  Derived m(size);
+  for (long i = 0; i < size; i++)
+    for (long j = FirstColumn(i); j < size; j++)
+      m.Set(i, j, Self().Get(i, j) + rhs.Self().Get(i, j));
+  return m;
+}
+
+template <typename Derived, typename T>
+Derived StaticMatrix<Derived, T>::SubtractScalar(const T rhs) const
+{
+  const long size = Self().Dimension();
+  Derived m(size);
+  for (long i = 0; i < size; i++)
+    for (long j = FirstColumn(i); j < size; j++)
+      m.Set(i, j, Self().Get(i, j) - rhs);
+  return m;
+}
+
+template <typename Derived, typename T>
+template <typename Other>
+Derived StaticMatrix<Derived, T>::SubtractMatrix(const StaticMatrix<Other, T>& rhs) const
+{
+  const long size = Self().Dimension();
+  if (rhs.Self().Dimension() != size)
+    throw SizeErr(size, rhs.Self().Dimension());
+
+  Derived m(size);
+  for (long i = 0; i < size; i++)
+    for (long j = FirstColumn(i); j < size; j++)
+      m.Set(i, j, Self().Get(i, j) - rhs.Self().Get(i, j));
+  return m;
+}
+
+template <typename Derived, typename T>
+Derived& StaticMatrix<Derived, T>::AddScalarInPlace(const T rhs)
+{
+  const long size = Self().Dimension();
+  for (long i = 0; i < size; i++)
+    for (long j = FirstColumn(i); j < size; j++)
+      Self().Set(i, j, Self().Get(i, j) + rhs);
+  return Self();
+}
+
+template <typename Derived, typename T>
+template <typename Other>
+Derived& StaticMatrix<Derived, T>::AddMatrixInPlace(const StaticMatrix<Other, T>& rhs)
+{
+  const long size = Self().Dimension();
+  if (rhs.Self().Dimension() != size)
+    throw SizeErr(size, rhs.Self().Dimension());
+
+  for (long i = 0; i < size; i++)
+    for (long j = FirstColumn(i); j < size; j++)
+      Self().Set(i, j, Self().Get(i, j) + rhs.Self().Get(i, j));
+  return Self();
+}
+
+template <typename Derived, typename T>
+Derived& StaticMatrix<Derived, T>::SubtractScalarInPlace(const T rhs)
+{
+  const long size = Self().Dimension();
+  for (long i = 0; i < size; i++)
+    for (long j = FirstColumn(i); j < size; j++)
+      Self().Set(i, j, Self().Get(i, j) - rhs);
+  return Self();
+}
+
+template <typename Derived, typename T>
+template <typename Other>
+Derived& StaticMatrix<Derived, T>::SubtractMatrixInPlace(const StaticMatrix<Other, T>& rhs)
+{
+  const long size = Self().Dimension();
+  if (rhs.Self().Dimension() != size)
+    throw SizeErr(size, rhs.Self().Dimension());
+
+  for (long i = 0; i < size; i++)
+    for (long j = FirstColumn(i); j < size; j++)
+      Self().Set(i, j, Self().Get(i, j) - rhs.Self().Get(i, j));
+  return Self();
+}
+
+template <typename Derived, typename T>
+Derived& StaticMatrix<Derived, T>::TransposeInPlace()
+{
+  if (Derived::Symmetric)
+    return Self();
+
+  const long size = Self().Dimension();
+  for (long i = 0; i < size; i++)
+  {
+    for (long j = i + 1; j < size; j++)
+    {
+      T tmp = Self().Get(i, j);
+      Self().Set(i, j, Self().Get(j, i));
+      Self().Set(j, i, tmp);
+    }
+  }
+  return Self();
+}
@@ -1,8 +1,14 @@
 #pragma once
+#include <algorithm>
 #include "Matrix.h"
+#include "StaticMatrix.h"
 
+// The virtual Matrix<T> operators are kept for runtime polymorphism and
+// forward to the StaticMatrix algorithms whenever both operands are known
+// to be SymMatrix, code that holds a SymMatrix directly can call those
+// algorithms itself and avoid virtual dispatch altogether
 template <typename T>
-class SymMatrix : virtual public Matrix<T>
+class SymMatrix : virtual public Matrix<T>, public StaticMatrix<SymMatrix<T>, T>
 {
   public:
     // Desc: Instantiates a new matrix of the given size
@@ -19,6 +25,11 @@ class SymMatrix : virtual public Matrix<T>
     // Post: A new matrix will be created will the same values of
     // the given parameter
     SymMatrix(const Matrix<T> * copy);
+    // Desc: Moves the given matrix into a new instance of the class
+    // Pre: None
+    // Post: A new matrix will take over the storage of the given
+    // parameter, which will be left empty
+    SymMatrix(SymMatrix<T>&& source);
     // Desc: Default destructor
     // Pre: None
     // Post: The matrix will be deleted
@@ -37,6 +48,12 @@ class SymMatrix : virtual public Matrix<T>
     // Pre: None
     // Post: The dimension of the matrix is returned
      virtual T GetSize() const;
+    // Desc: Returns the dimension of the matrix without virtual dispatch
+    // Pre: None
+    // Post: The dimension of the matrix is returned
+    inline long Dimension() const { return m_size; }
+    // (row, col) and (col, row) share one element of the packed triangle
+    static constexpr bool Symmetric = true;
 
     // Desc: Transposes the matrix
     // Pre: None
@@ -55,6 +72,18 @@ class SymMatrix : virtual public Matrix<T>
     // Pre: Parameters row and col must be between 0 and the size of the matrix
     // Post: The value of the matrix will be set to the supplied value
     virtual Matrix<T>& operator()(const long row, const long col, const T val);
+    // Desc: Returns the value in the requested matrix index, without
+    // virtual dispatch or subscript checks in release builds
+    // Pre: Parameters row and col must be between 0 and the size of the matrix
+    // Post: The value of the matrix in that position will be returned,
+    // a bad subscript only throws in debug builds
+    inline T Get(const long row, const long col) const;
+    // Desc: Sets a value in the matrix, without virtual dispatch or
+    // subscript checks in release builds
+    // Pre: Parameters row and col must be between 0 and the size of the matrix
+    // Post: The value of the matrix will be set to the supplied value,
+    // a bad subscript only throws in debug builds
+    inline void Set(const long row, const long col, const T val);
     // Desc: Creates a new matrix with the values of the calling object
     // multiplied by the rhs parameter
     // Pre: The type T must have + and * defined for it
@@ -131,12 +160,37 @@ class SymMatrix : virtual public Matrix<T>
     // Pre: The rhs parameter must be of same size as object
     // Post: The matrix will take on the values of the rhs parameter
     virtual SymMatrix<T>& operator=(const SymMatrix<T>& rhs);
+    // Desc: Moves the value of the parameter into itself
+    // Pre: None
+    // Post: The matrix will take over the storage of the rhs parameter
+    SymMatrix<T>& operator=(SymMatrix<T>&& rhs);
+
+    // Desc: Returns the packed upper triangle part of a row
+    // Pre: Parameter row must be between 0 and the size of the matrix
+    // Post: A pointer to element (row, row) is returned, the elements
+    // (row, row + 1) .. (row, size - 1) follow it contiguously
+    inline T* Row(const long row) { return m_data + RowOffset(row); }
+    inline const T* Row(const long row) const { return m_data + RowOffset(row); }
 
   private:
+    // Desc: Hands a computed matrix to the virtual interface
+    // Pre: None
+    // Post: m takes this matrix's zero tolerance and is returned
+    // as a smart pointer to the base class
+    unique_ptr<Matrix<T>> Adapt(SymMatrix<T>&& m) const;
+    // Desc: Returns the position of element (row, row) in the packed buffer
+    // Pre: Parameter row must be between 0 and the size of the matrix
+    // Post: The sum of the lengths of all previous rows is returned
+    inline long RowOffset(const long row) const { return row * m_size - (row * (row - 1)) / 2; }
+    // Desc: Returns the number of elements in the packed upper triangle
+    // Pre: None
+    // Post: size * (size + 1) / 2 is returned
+    inline long PackedSize() const { return (m_size * (m_size + 1)) / 2; }
+
     // the dimension of the matrix
     long m_size;
-    // the data values of the Matrix
-    Vector<T> * m_data;
+    // the upper triangle, stored row after row in one allocation
+    T * m_data;
     // the zero tolerance of the Matrix
     // i.e. when a value "is close enough" to 0
     T m_zero;
@@ -1,29 +1,35 @@
 template <typename T>
 SymMatrix<T>::SymMatrix(const long size)
-: m_size(size), m_data(new Vector<T>[size]), m_zero(0)
+: m_size(size), m_data(new T[(size * (size + 1)) / 2]()), m_zero(0)
 {
-  for (long i = 0; i < m_size; i++)
-    m_data[i] = Vector<T>(m_size - i);
 }
 
 template <typename T>
 SymMatrix<T>::SymMatrix(const SymMatrix<T>& copy)
-: m_size(copy.GetSize()), m_data(new Vector<T>[copy.GetSize()]), m_zero(copy.GetTolerance())
+: m_size(copy.m_size), m_data(new T[copy.PackedSize()]), m_zero(copy.GetTolerance())
 {
-  for (long i = 0; i < m_size; i++)
-    m_data[i] = Vector<T>(copy.m_data[i]);
+  std::copy(copy.m_data, copy.m_data + PackedSize(), m_data);
 }
 
 template <typename T>
 SymMatrix<T>::SymMatrix(const Matrix<T> * copy)
-: m_size(copy->GetSize()), m_data(new Vector<T>[copy->GetSize()]), m_zero(copy->GetTolerance())
+: m_size(copy->GetSize()), m_data(nullptr), m_zero(copy->GetTolerance())
 {
+  m_data = new T[PackedSize()];
   for (long i = 0; i < m_size; i++)
-    m_data[i] = Vector<T>(m_size - i);
+  {
+    T* row = Row(i);
+    for (long j = i; j < m_size; j++)
+      row[j - i] = (*copy)(j, i);
+  }
+}
 
-  for (long i = 0; i < m_size; i++)
-    for (long j = 0; j < m_size; j++)
-      (*this)(i, j, (*copy)(i, j));
+template <typename T>
+SymMatrix<T>::SymMatrix(SymMatrix<T>&& source)
+: m_size(source.m_size), m_data(source.m_data), m_zero(source.m_zero)
+{
+  source.m_data = nullptr;
+  source.m_size = 0;
 }
 
 template <typename T>
@@ -39,8 +45,6 @@ void SymMatrix<T>::SetTolerance(const T tol)
   if (tol < 0)
     throw RangeErr<T>(tol);
   m_zero = tol;
-  for (long i = 0; i < m_size; i++)
-    m_data[i].SetTolerance(m_zero);
 }
 
 template <typename T>
@@ -58,33 +62,13 @@ T SymMatrix<T>::GetSize() const
 template <typename T>
 Matrix<T>& SymMatrix<T>::Transpose()
 {
-  for (long i = 0; i < m_size - 1; i++)
-  {
-    for (long j = i + 1; j < m_size; j++)
-    {
-      T tmp = (*this)(i, j);
-      (*this)(i, j, (*this)(j, i));
-      (*this)(j, i, tmp);
-    }
-  }
-  return *this;
+  return this->TransposeInPlace();
 }
 
 template <typename T>
 bool SymMatrix<T>::IsDiagDom() const
 {
-  for (long i = 0; i < m_size; i++)
-  {
-    T sum = 0;
-    for (long j = 0; j < m_size; j++)
-    {
-      if (i != j)
-        sum += abs((*this)(i, j));
-    }
-    if (sum > abs((*this)(i, i)))
-      return false;
-  }
-  return true;
+  return this->DiagonallyDominant();
 }
 
 template <typename T>
@@ -96,9 +80,9 @@ T SymMatrix<T>::operator()(const long row, const long col) const
     throw SubscriptErr(col);
 
   if (row <= col)
-    return m_data[row][col - row];
+    return Row(row)[col - row];
   else
-    return m_data[col][row - col];
+    return Row(col)[row - col];
 }
 
 template <typename T>
@@ -110,35 +94,58 @@ Matrix<T>& SymMatrix<T>::operator()(const long row, const long col, const T val)
     throw SubscriptErr(col);
 
   if (row <= col)
-    m_data[row][col - row] = val;
+    Row(row)[col - row] = val;
   else
-    m_data[col][row - col] = val;
+    Row(col)[row - col] = val;
 
   return *this;
 }
 
+template <typename T>
+T SymMatrix<T>::Get(const long row, const long col) const
+{
+  CheckSubscript(row, m_size);
+  CheckSubscript(col, m_size);
+  return (row <= col) ? Row(row)[col - row] : Row(col)[row - col];
+}
+
+template <typename T>
+void SymMatrix<T>::Set(const long row, const long col, const T val)
+{
+  CheckSubscript(row, m_size);
+  CheckSubscript(col, m_size);
+  if (row <= col)
+    Row(row)[col - row] = val;
+  else
+    Row(col)[row - col] = val;
+}
+
 template <typename T>
 unique_ptr<Matrix<T>> SymMatrix<T>::operator*(const T rhs) const
 {
-  unique_ptr<Matrix<T>> m(new SymMatrix<T>(*this));
-  for (long i = 0; i < m_size; i++)
-    for (long j = 0; j < m_size; j++)
-      (*m)(i, j, (*m)(i, j) * rhs);
-  return m;
+  return Adapt(this->MultiplyScalar(rhs));
 }
 
 template <typename T>
 Vector<T> SymMatrix<T>::operator*(const Vector<T>& rhs) const
 {
+  if (rhs.GetSize() != m_size)
+    throw SizeErr(m_size, rhs.GetSize());
+
+  // walk the packed triangle once, each stored (i, j) element
+  // contributes to both result i and, off the diagonal, result j
   Vector<T> vect = Vector<T>(m_size);
   for (long i = 0; i < m_size; i++)
   {
-    T sum = 0;
-    for (long j = 0; j < m_size; j++)
+    const T* row = Row(i);
+    const T x_i = rhs.Get(i);
+    T sum = row[0] * x_i;
+    for (long j = i + 1; j < m_size; j++)
     {
-      sum += ((*this)(i, j) * rhs[j]);
+      sum += (row[j - i] * rhs.Get(j));
+      vect.Get(j) += (row[j - i] * x_i);
     }
-    vect[i] = sum;
+    vect.Get(i) += sum;
   }
   return vect;
 }
@@ -146,6 +153,10 @@ Vector<T> SymMatrix<T>::operator*(const Vector<T>& rhs) const
 template <typename T>
 unique_ptr<Matrix<T>> SymMatrix<T>::operator*(const Matrix<T>& rhs) const
 {
+  auto sym = dynamic_cast<const SymMatrix<T>*>(&rhs);
+  if (sym)
+    return Adapt(this->MultiplyMatrix(*sym));
+
   unique_ptr<Matrix<T>> m(new SymMatrix<T>(*this));
   for (long i = 0; i < m_size; i++)
   {
@@ -154,7 +165,7 @@ unique_ptr<Matrix<T>> SymMatrix<T>::operator*(const Matrix<T>& rhs) const
       T sum = 0;
       for (long k = 0; k < m_size; k++)
       {
-        sum += ((*this)(i, k) * rhs(k, j));
+        sum += (Get(i, k) * rhs(k, j));
       }
       (*m)(i, j, sum);
     }
@@ -165,107 +176,143 @@ unique_ptr<Matrix<T>> SymMatrix<T>::operator*(const Matrix<T>& rhs) const
 template <typename T>
 unique_ptr<Matrix<T>> SymMatrix<T>::operator+(const T rhs) const
 {
-  //SymMatrix<T> * m = new SymMatrix<T>(*this);
-  unique_ptr<Matrix<T>> m(new SymMatrix<T>(*this));
-  for (long i = 0; i < m_size; i++)
-    for (long j = 0; j < m_size; j++)
-      (*m)(i, j, (*m)(i, j) + rhs);
-  return m;
+  return Adapt(this->AddScalar(rhs));
 }
 
 template <typename T>
 unique_ptr<Matrix<T>> SymMatrix<T>::operator+(const Matrix<T>& rhs) const
 {
-  //SymMatrix<T> * m = new SymMatrix<T>(*this);
+  auto sym = dynamic_cast<const SymMatrix<T>*>(&rhs);
+  if (sym)
+    return Adapt(this->AddMatrix(*sym));
+
   unique_ptr<Matrix<T>> m(new SymMatrix<T>(*this));
   for (long i = 0; i < m_size; i++)
     for (long j = 0; j < m_size; j++)
-      (*m)(i, j, (*m)(i, j) + rhs(i, j));
+      (*m)(i, j, (*this)(i, j) + rhs(i, j));
   return m;
 }
 
 template <typename T>
 Matrix<T>& SymMatrix<T>::operator+=(const T rhs)
 {
-  *this = *(*this + rhs);
-  return *this;
+  return this->AddScalarInPlace(rhs);
 }
 
 template <typename T>
 Matrix<T>& SymMatrix<T>::operator+=(const Matrix<T>& rhs)
 {
-  *this = *(*this + rhs);
+  auto sym = dynamic_cast<const SymMatrix<T>*>(&rhs);
+  if (sym)
+    return this->AddMatrixInPlace(*sym);
+
+  // the upper triangle holds every element, so only it is visited
+  for (long i = 0; i < m_size; i++)
+    for (long j = i; j < m_size; j++)
+      Set(i, j, Get(i, j) + rhs(i, j));
   return *this;
 }
 
 template <typename T>
 unique_ptr<Matrix<T>> SymMatrix<T>::operator-(const T rhs) const
 {
-  //SymMatrix<T> * m = new SymMatrix<T>(*this);
-  unique_ptr<Matrix<T>> m(new SymMatrix<T>(*this));
-  *m += (rhs * -1);
-  return m;
+  return Adapt(this->SubtractScalar(rhs));
 }
 
 template <typename T>
 unique_ptr<Matrix<T>> SymMatrix<T>::operator-(const Matrix<T>& rhs) const
 {
-  //SymMatrix<T> * m = new SymMatrix<T>(*this);
+  auto sym = dynamic_cast<const SymMatrix<T>*>(&rhs);
+  if (sym)
+    return Adapt(this->SubtractMatrix(*sym));
+
   unique_ptr<Matrix<T>> m(new SymMatrix<T>(*this));
-  *m += *(rhs * -1);
+  for (long i = 0; i < m_size; i++)
+    for (long j = i; j < m_size; j++)
+      (*m)(i, j, Get(i, j) - rhs(i, j));
   return m;
 }
 
 template <typename T>
 Matrix<T>& SymMatrix<T>::operator-=(const T rhs)
 {
-  *this += (rhs * -1);
-  return *this;
+  return this->SubtractScalarInPlace(rhs);
 }
 
 template <typename T>
 Matrix<T>& SymMatrix<T>::operator-=(const Matrix<T>& rhs)
 {
-  *this += *(rhs * -1);
+  auto sym = dynamic_cast<const SymMatrix<T>*>(&rhs);
+  if (sym)
+    return this->SubtractMatrixInPlace(*sym);
+
+  for (long i = 0; i < m_size; i++)
+    for (long j = i; j < m_size; j++)
+      Set(i, j, Get(i, j) - rhs(i, j));
   return *this;
 }
 
 template <typename T>
 Matrix<T>& SymMatrix<T>::operator=(const Matrix<T>& rhs)
 {
+  if (this == &rhs)
+    return *this;
+
   auto old_size = m_size;
   m_size = rhs.GetSize();
   if (m_size != old_size)
   {
     delete[] m_data;
-    m_data = new Vector<T>[m_size];
-    for (long i = 0; i < m_size; i++)
-      m_data[i] = Vector<T>(m_size - i);
+    m_data = new T[PackedSize()];
   }
 
   m_zero = rhs.GetTolerance();
   for (long i = 0; i < m_size; i++)
-    for (long j = 0; j < m_size; j++)
-      (*this)(i, j, rhs(i, j));
+  {
+    T* row = Row(i);
+    for (long j = i; j < m_size; j++)
+      row[j - i] = rhs(j, i);
+  }
   return *this;
 }
 
 template <typename T>
 SymMatrix<T>& SymMatrix<T>::operator=(const SymMatrix<T>& rhs)
 {
+  if (this == &rhs)
+    return *this;
+
   auto old_size = m_size;
   m_size = rhs.GetSize();
   if (m_size != old_size)
   {
     delete[] m_data;
-    m_data = new Vector<T>[m_size];
-    for (long i = 0; i < m_size; i++)
-      m_data[i] = Vector<T>(m_size - i);
+    m_data = new T[PackedSize()];
   }
 
   m_zero = rhs.GetTolerance();
-  for (long i = 0; i < m_size; i++)
-    for (long j = 0; j < m_size; j++)
-      (*this)(i, j, rhs(i, j));
+  std::copy(rhs.m_data, rhs.m_data + PackedSize(), m_data);
+  return *this;
+}
+
+template <typename T>
+SymMatrix<T>& SymMatrix<T>::operator=(SymMatrix<T>&& rhs)
+{
+  if (this == &rhs)
+    return *this;
+
+  delete[] m_data;
+  m_size = rhs.m_size;
+  m_data = rhs.m_data;
+  m_zero = rhs.m_zero;
+  rhs.m_data = nullptr;
+  rhs.m_size = 0;
   return *this;
-}
\ No newline at end of file
+}
+
+template <typename T>
+unique_ptr<Matrix<T>> SymMatrix<T>::Adapt(SymMatrix<T>&& m) const
+{
+  m.m_zero = m_zero;
+  return unique_ptr<Matrix<T>>(new SymMatrix<T>(std::move(m)));
+}
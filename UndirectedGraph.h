@@ -1,16 +1,39 @@
 #pragma once
 #include "SymMatrix.h"
+#include "NeighborRange.h"
+#include "MappedFile.h"
+#include "DenseMatrixReader.h"
+#include <algorithm>
 #include <mutex>
 #include <vector>
+#include <unordered_map>
 
 template <typename T>
 class UndirectedGraph
 {
   protected:
     long graph_size;
+    // one label per node, or nullptr while the graph has no labels
     std::string* node_labels;
+    // label -> index of its first node, only built once labels are read
+    std::unordered_map<std::string, long> label_index;
     SymMatrix<T> matrix;
-    std::mutex mtx;
+    // sorted non-zero columns of each row of the matrix
+    std::vector<std::vector<long>> neighbor_lists;
+    // guards the storage until the graph is frozen
+    mutable std::mutex mtx;
+    bool frozen;
+
+    std::unique_lock<std::mutex> ReadLock() const;
+    std::unique_lock<std::mutex> WriteLock() const;
+    void RebuildNeighborLists();
+    void RebuildLabelIndex();
+    void ResizeLabels(const long size);
+    void AssignLabels(std::vector<std::string>& labels);
+    void LinkNeighbor(const long row, const long col);
+    void UnlinkNeighbor(const long row, const long col);
+    // SetEdgeWeight without the lock, for callers that already hold it
+    void StoreEdgeWeight(const long node_a, const long node_b, const T weight);
 
   public:
     UndirectedGraph(const long size = 1);
@@ -22,36 +45,51 @@ class UndirectedGraph
     virtual inline long GetSize() const { return graph_size; }
     virtual std::string GetNodeLabel(const long idx) const;
     virtual long GetNodeFromLabel(const std::string& label) const;
-    virtual bool DoesEdgeExist(const std::string& node_a, const std::string& node_b);
-    virtual bool DoesEdgeExist(const long node_a, const long node_b);
-    virtual double GetEdgeWeight(const std::string& node_a, const std::string& node_b);
-    virtual double GetEdgeWeight(const long node_a, const long node_b);
+    // after Freeze() the graph is immutable and every query below
+    // skips the mutex, so any number of threads may read it at once.
+    // Thaw() makes it mutable again and requires that no thread is reading
+    inline void Freeze() { frozen = true; }
+    inline void Thaw() { frozen = false; }
+    inline bool IsFrozen() const { return frozen; }
+    virtual bool DoesEdgeExist(const std::string& node_a, const std::string& node_b) const;
+    virtual bool DoesEdgeExist(const long node_a, const long node_b) const;
+    virtual double GetEdgeWeight(const std::string& node_a, const std::string& node_b) const;
+    virtual double GetEdgeWeight(const long node_a, const long node_b) const;
     virtual void SetEdgeWeight(const long node_a, const long node_b, const T weight);
-    virtual long GetDegree(const long idx);
-    virtual std::vector<long> GetNeighbors(const long idx);
+    virtual long GetDegree(const long idx) const;
+    // all node ids ordered by degree, highest first unless descending is false
+    std::vector<long> GetNodesByDegree(const bool descending = true) const;
+    virtual std::vector<long> GetNeighbors(const long idx) const;
+    // lock and allocation free view of the neighbors of idx,
+    // callers must not modify the graph while holding the range
+    virtual NeighborRange Neighbors(const long idx) const;
     virtual SymMatrix<T> GetDistanceMatrix() const;
     virtual SymMatrix<T> GetAdjacencyMatrix() const;
+    // reads the same format as operator>> from a memory mapping, parsing
+    // only the upper triangle and writing it straight into the matrix
+    // rows. Throws FileErr if the file cannot be opened and FormatErr if
+    // values are missing
+    void ReadDenseMatrix(const std::string& file_name);
 
     friend ostream& operator<<(ostream& os, const UndirectedGraph& graph)
     {
       os << "[Labels]" << std::endl;
       for (long i = 0; i < graph.graph_size; i++)
-        os << "   " << graph.node_labels[i] << std::endl;
+        os << "   " << graph.GetNodeLabel(i) << std::endl;
       os << "[Edges]" << std::endl << graph.matrix << std::endl;
       return os;
     }
 
     friend ifstream& operator>>(ifstream& is, UndirectedGraph<T>& graph)
     {
-      long old_size = graph.graph_size;
-      is >> graph.graph_size;
-      if (old_size != graph.graph_size)
-      {
-        delete[] graph.node_labels;
-        graph.node_labels = new std::string[graph.graph_size];
-      }
-      for (long i = 0; i < graph.graph_size; i++)
-        is >> graph.node_labels[i];
+      auto lock = graph.WriteLock();
+      long size = 0;
+      is >> size;
+      std::vector<std::string> labels(size);
+      for (auto& label : labels)
+        is >> label;
+      graph.ResizeLabels(size);
+      graph.AssignLabels(labels);
 
       graph.matrix = SymMatrix<T>(graph.graph_size);
       for (long row = 0; row < graph.graph_size; row++)
@@ -63,6 +101,7 @@ class UndirectedGraph
           graph.matrix(row, col, value);
         }
       }
+      graph.RebuildNeighborLists();
 
       return is;
     }
@@ -1,20 +1,21 @@
 template <typename T>
 UndirectedGraph<T>::UndirectedGraph(const long size)
-: graph_size(size), node_labels(new std::string[size]), matrix(size)
+: graph_size(size), node_labels(nullptr), matrix(size), neighbor_lists(size), frozen(false)
 {
 }
 
 template <typename T>
 UndirectedGraph<T>::UndirectedGraph(const UndirectedGraph<T>& copy)
-: graph_size(copy.GetSize()), node_labels(new std::string[copy.GetSize()]), matrix(copy.matrix)
+: graph_size(copy.GetSize()), node_labels(copy.node_labels ? new std::string[copy.GetSize()] : nullptr), label_index(copy.label_index),
+  matrix(copy.matrix), neighbor_lists(copy.neighbor_lists), frozen(false)
 {
-  for (long i = 0; i < graph_size; i++)
-    node_labels[i] = copy.GetNodeLabel(i);
+  if (node_labels)
+    std::copy(copy.node_labels, copy.node_labels + graph_size, node_labels);
 }
 
 template <typename T>
 UndirectedGraph<T>::UndirectedGraph(UndirectedGraph<T>&& source)
-: graph_size(source.graph_size), node_labels(source.node_labels), matrix(source.matrix)
+: graph_size(source.graph_size), node_labels(source.node_labels), label_index(std::move(source.label_index)), matrix(std::move(source.matrix)), neighbor_lists(std::move(source.neighbor_lists)), frozen(source.frozen)
 {
   source.node_labels = nullptr;
   source.graph_size = 0;
@@ -30,46 +31,49 @@ UndirectedGraph<T>::~UndirectedGraph()
 template <typename T>
 UndirectedGraph<T>& UndirectedGraph<T>::operator=(const UndirectedGraph<T>& copy)
 {
+  auto lock = WriteLock();
   delete[] node_labels;
   graph_size = copy.graph_size;
-  node_labels = new std::string[graph_size];
-  for (long i = 0; i < graph_size; i++)
-    node_labels[i] = copy.node_labels[i];
+  node_labels = (copy.node_labels ? new std::string[graph_size] : nullptr);
+  if (node_labels)
+    std::copy(copy.node_labels, copy.node_labels + graph_size, node_labels);
+  label_index = copy.label_index;
   matrix = copy.matrix;
+  neighbor_lists = copy.neighbor_lists;
   return *this;
 }
 
 template <typename T>
 std::string UndirectedGraph<T>::GetNodeLabel(const long idx) const
 {
-  if (idx > graph_size)
+  if (idx < 0 || idx >= graph_size)
     throw SubscriptErr(idx);
-  return node_labels[idx];
+  return (node_labels ? node_labels[idx] : std::string());
 }
 
 template <typename T>
 long UndirectedGraph<T>::GetNodeFromLabel(const std::string& label) const
 {
-  for (long i = 0; i < graph_size; i++)
-    if (label == GetNodeLabel(i))
-      return i;
-  throw NodeNameErr(label);
+  auto itr = label_index.find(label);
+  if (itr == label_index.end())
+    throw NodeNameErr(label);
+  return itr->second;
 }
 
 template <typename T>
-bool UndirectedGraph<T>::DoesEdgeExist(const std::string& node_a, const std::string& node_b)
+bool UndirectedGraph<T>::DoesEdgeExist(const std::string& node_a, const std::string& node_b) const
 {
   return (GetEdgeWeight(node_a, node_b) != 0);
 }
 
 template <typename T>
-bool UndirectedGraph<T>::DoesEdgeExist(const long node_a, const long node_b)
+bool UndirectedGraph<T>::DoesEdgeExist(const long node_a, const long node_b) const
 {
   return (GetEdgeWeight(node_a, node_b) != 0);
 }
 
 template <typename T>
-double UndirectedGraph<T>::GetEdgeWeight(const std::string& node_a, const std::string& node_b)
+double UndirectedGraph<T>::GetEdgeWeight(const std::string& node_a, const std::string& node_b) const
 {
   long a = GetNodeFromLabel(node_a);
   long b = GetNodeFromLabel(node_b);
@@ -77,40 +81,86 @@ double UndirectedGraph<T>::GetEdgeWeight(const std::string& node_a, const std::s
 }
 
 template <typename T>
-double UndirectedGraph<T>::GetEdgeWeight(const long node_a, const long node_b)
+double UndirectedGraph<T>::GetEdgeWeight(const long node_a, const long node_b) const
 {
-  std::lock_guard<std::mutex> lock(mtx);
+  auto lock = ReadLock();
   return matrix(node_a, node_b);
 }
 
 template <typename T>
 void UndirectedGraph<T>::SetEdgeWeight(const long node_a, const long node_b, const T weight)
 {
-  std::lock_guard<std::mutex> lock(mtx);
+  auto lock = WriteLock();
+  StoreEdgeWeight(node_a, node_b, weight);
+}
+
+template <typename T>
+void UndirectedGraph<T>::StoreEdgeWeight(const long node_a, const long node_b, const T weight)
+{
   matrix(node_a, node_b, weight);
+  if (weight != 0)
+  {
+    LinkNeighbor(node_a, node_b);
+    LinkNeighbor(node_b, node_a);
+  }
+  else
+  {
+    UnlinkNeighbor(node_a, node_b);
+    UnlinkNeighbor(node_b, node_a);
+  }
 }
 
 template <typename T>
-long UndirectedGraph<T>::GetDegree(const long idx)
+long UndirectedGraph<T>::GetDegree(const long idx) const
 {
-  std::lock_guard<std::mutex> lock(mtx);
-  long degree = 0;
-  for (long col = 0; col < graph_size; col++)
-    degree += ((matrix(idx, col) != 0) ? 1 : 0);
-  return degree;
+  auto lock = ReadLock();
+  // the neighbor lists double as the degree table, they are
+  // built on load and kept current by SetEdgeWeight
+  if (idx < 0 || idx >= static_cast<long>(neighbor_lists.size()))
+    throw SubscriptErr(idx);
+  return static_cast<long>(neighbor_lists[idx].size());
 }
 
 template <typename T>
-std::vector<long> UndirectedGraph<T>::GetNeighbors(const long idx)
+std::vector<long> UndirectedGraph<T>::GetNodesByDegree(const bool descending) const
 {
-  std::lock_guard<std::mutex> lock(mtx);
-  std::vector<long> neighbors;
+  // counting sort on degree, ties keep ascending node id
+  std::vector<long> degrees(graph_size);
+  long max_degree = 0;
+  for (long i = 0; i < graph_size; i++)
+  {
+    degrees[i] = GetDegree(i);
+    if (degrees[i] > max_degree)
+      max_degree = degrees[i];
+  }
 
+  std::vector<long> starts(max_degree + 2, 0);
   for (long i = 0; i < graph_size; i++)
-    if (matrix(idx, i) != 0)
-      neighbors.push_back(i);
+    starts[(descending ? max_degree - degrees[i] : degrees[i]) + 1]++;
+  for (long d = 0; d <= max_degree; d++)
+    starts[d + 1] += starts[d];
 
-  return neighbors;
+  std::vector<long> order(graph_size);
+  for (long i = 0; i < graph_size; i++)
+    order[starts[descending ? max_degree - degrees[i] : degrees[i]]++] = i;
+  return order;
+}
+
+template <typename T>
+std::vector<long> UndirectedGraph<T>::GetNeighbors(const long idx) const
+{
+  auto lock = ReadLock();
+  auto neighbors = Neighbors(idx);
+  return std::vector<long>(neighbors.begin(), neighbors.end());
+}
+
+template <typename T>
+NeighborRange UndirectedGraph<T>::Neighbors(const long idx) const
+{
+  if (idx < 0 || idx >= static_cast<long>(neighbor_lists.size()))
+    throw SubscriptErr(idx);
+  const auto& row = neighbor_lists[idx];
+  return NeighborRange(row.data(), row.data() + row.size());
 }
 
 template <typename T>
@@ -118,12 +168,13 @@ SymMatrix<T> UndirectedGraph<T>::GetDistanceMatrix() const
 {
   const T infinity = -1;
 
+  SymMatrix<T> adjacency = GetAdjacencyMatrix();
   SymMatrix<T> distances(graph_size);
   for (long row = 0; row < graph_size; row++)
   {
     for (long col = 0; col <= row; col++)
     {
-      T value = matrix(row, col);
+      T value = adjacency(row, col);
       if (col == row)
         value = 0;
       else if (value == 0)
@@ -132,18 +183,26 @@ SymMatrix<T> UndirectedGraph<T>::GetDistanceMatrix() const
     }
   }
 
+  std::vector<T> through_k(graph_size);
   for (long k = 0; k < graph_size; k++)
   {
+    // distances to k do not change while k is the intermediate node,
+    // so copy them out once and sweep each packed row contiguously
+    for (long i = 0; i < graph_size; i++)
+      through_k[i] = distances.Get(i, k);
+
     for (long i = 0; i < graph_size; i++)
     {
-      for (long j = 0; j < graph_size; j++)
+      const T d_ik = through_k[i];
+      if (d_ik == infinity)
+        continue;
+
+      T* row = distances.Row(i);
+      for (long j = i; j < graph_size; j++)
       {
-        if ((distances(i, j) > distances(i, k) + distances(k, j) || distances(i, j) == infinity)
-            && distances(i, k) != infinity
-            && distances(k, j) != infinity)
-        {
-          distances(i, j, (distances(i, k) + distances(k, j)));
-        }
+        const T d_kj = through_k[j];
+        if (d_kj != infinity && (row[j - i] == infinity || row[j - i] > d_ik + d_kj))
+          row[j - i] = d_ik + d_kj;
       }
     }
   }
@@ -156,3 +215,113 @@ SymMatrix<T> UndirectedGraph<T>::GetAdjacencyMatrix() const
 {
   return matrix;
 }
+
+template <typename T>
+void UndirectedGraph<T>::ReadDenseMatrix(const std::string& file_name)
+{
+  MappedFile file(file_name);
+  auto lock = WriteLock();
+  const char* pos = file.begin();
+  std::vector<std::string> labels;
+  auto size = ScanDenseHeader(pos, file.end(), labels, file_name);
+
+  matrix = SymMatrix<T>(size);
+  // cells arrive in row order above the diagonal, which keeps every
+  // neighbor list sorted as it is appended to
+  neighbor_lists.assign(size, std::vector<long>());
+  ScanDenseRows<T>(pos, file.end(), size, [this](const long row, const long col, const T value)
+  {
+    matrix.Row(row)[col - row] = value;
+    neighbor_lists[row].push_back(col);
+    if (row != col)
+      neighbor_lists[col].push_back(row);
+  }, file_name);
+
+  ResizeLabels(size);
+  AssignLabels(labels);
+}
+
+template <typename T>
+void UndirectedGraph<T>::RebuildNeighborLists()
+{
+  neighbor_lists.assign(matrix.GetSize(), std::vector<long>());
+  for (long row = 0; row < matrix.GetSize(); row++)
+    for (long col = 0; col < matrix.GetSize(); col++)
+      if (matrix(row, col) != 0)
+        neighbor_lists[row].push_back(col);
+}
+
+template <typename T>
+void UndirectedGraph<T>::LinkNeighbor(const long row, const long col)
+{
+  auto& list = neighbor_lists.at(row);
+  auto itr = std::lower_bound(list.begin(), list.end(), col);
+  if (itr == list.end() || *itr != col)
+    list.insert(itr, col);
+}
+
+template <typename T>
+void UndirectedGraph<T>::UnlinkNeighbor(const long row, const long col)
+{
+  auto& list = neighbor_lists.at(row);
+  auto itr = std::lower_bound(list.begin(), list.end(), col);
+  if (itr != list.end() && *itr == col)
+    list.erase(itr);
+}
+
+template <typename T>
+std::unique_lock<std::mutex> UndirectedGraph<T>::ReadLock() const
+{
+  // a frozen graph never changes, so readers need no lock
+  if (frozen)
+    return std::unique_lock<std::mutex>(mtx, std::defer_lock);
+  return std::unique_lock<std::mutex>(mtx);
+}
+
+template <typename T>
+std::unique_lock<std::mutex> UndirectedGraph<T>::WriteLock() const
+{
+  if (frozen)
+    throw FrozenGraphErr();
+  return std::unique_lock<std::mutex>(mtx);
+}
+
+template <typename T>
+void UndirectedGraph<T>::RebuildLabelIndex()
+{
+  // emplace keeps the first node of a repeated label, as the old linear search did
+  label_index.clear();
+  label_index.reserve(graph_size);
+  for (long i = 0; i < graph_size; i++)
+    label_index.emplace(node_labels[i], i);
+}
+
+template <typename T>
+void UndirectedGraph<T>::ResizeLabels(const long size)
+{
+  // labels of a graph that changes size no longer fit it, so they are
+  // dropped. Unlabeled graphs keep no per node label storage at all
+  if (size != graph_size)
+  {
+    delete[] node_labels;
+    node_labels = nullptr;
+    label_index.clear();
+    graph_size = size;
+  }
+}
+
+template <typename T>
+void UndirectedGraph<T>::AssignLabels(std::vector<std::string>& labels)
+{
+  // an empty list leaves the graph unlabeled
+  delete[] node_labels;
+  node_labels = nullptr;
+  label_index.clear();
+  if (labels.empty())
+    return;
+
+  node_labels = new std::string[graph_size];
+  for (long i = 0; i < graph_size && i < static_cast<long>(labels.size()); i++)
+    node_labels[i] = std::move(labels[i]);
+  RebuildLabelIndex();
+}
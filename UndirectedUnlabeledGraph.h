@@ -1,29 +1,135 @@
 #pragma once
 #include "UndirectedGraph.h"
-#include <set>
+#include "CSRAdjacency.h"
+#include "BitAdjacency.h"
+#include "CompressedAdjacency.h"
+#include "MappedAdjacency.h"
+#include "MappedFile.h"
+#include "EdgeListScanner.h"
+#include "GraphFormats.h"
 #include <tuple>
+#include <thread>
+#include <cstring>
 
 std::vector<std::string> split(std::string value, const std::string delimiter);
 
+// Dense keeps the full SymMatrix, Sparse keeps only a CSRAdjacency
+// so memory is O(n + m) and neighbor scans are O(degree), Bitset
+// keeps a BitAdjacency with one bit per cell, Compressed keeps a
+// CompressedAdjacency of gap coded varint rows. Dense and Sparse keep
+// the edge weights read from the file, Bitset and Compressed only
+// keep presence. Mapped reads a MappedAdjacency straight out of a
+// binary snapshot, it is entered through ReadSnapshot and turns into
+// Sparse the first time the graph is changed
+enum class GraphStorage { Dense, Sparse, Bitset, Compressed, Mapped };
+
 template <typename T>
 class UndirectedUnlabeledGraph : public UndirectedGraph<T>
 {
   std::string read_delimeter;
+  GraphStorage storage;
+  // the lowest node id of the graph file, 1 for the METIS and Matrix Market
+  // formats whose node 0 only pads the ids. It is 0 for every other format
+  long id_base;
+  CSRAdjacency<T> sparse;
+  BitAdjacency<T> bitset;
+  CompressedAdjacency<T> compressed;
+  MappedAdjacency<T> mapped;
+
+  protected:
+    typedef std::pair<std::pair<long, long>, T> WeightedEdge;
+
+    // replaces the contents of whichever storage is in use
+    template <typename EdgeContainer>
+    void BuildStorage(const long size, const EdgeContainer& edges);
+    // SetEdgeWeight on whichever storage is in use, without the lock
+    void StoreEdgeWeight(const long node_a, const long node_b, const T weight);
+    // sorts edges by node pair on up to thread_count threads, then keeps
+    // only the last entry of each pair, as repeated assignment into a map would
+    static void SortEdges(std::vector<WeightedEdge>& edges, const long thread_count);
+    // merges a batch sorted by SortEdges with the current edges into
+    // merged, in node pair order. Zero weights in the batch drop the edge
+    template <typename Edge>
+    void MergeEdgeUpdates(const std::vector<WeightedEdge>& batch, std::vector<Edge>& merged) const;
+    // appends an edge to a merged list, presence only lists drop the weight
+    static void AppendEdge(std::vector<WeightedEdge>& edges, const std::pair<long, long>& pair, const T weight) { edges.push_back(WeightedEdge(pair, weight)); }
+    static void AppendEdge(std::vector<std::pair<long, long>>& edges, const std::pair<long, long>& pair, const T) { edges.push_back(pair); }
+    // copies a mapped snapshot into sparse storage so it can be changed
+    void UnmapStorage();
+
   public:
-    UndirectedUnlabeledGraph(const long size = 1, const std::string& read_delim = ",");
+    UndirectedUnlabeledGraph(const long size = 1, const std::string& read_delim = ",", const GraphStorage mode = GraphStorage::Dense);
     UndirectedUnlabeledGraph(const UndirectedUnlabeledGraph<T>& copy);
     UndirectedUnlabeledGraph(UndirectedUnlabeledGraph<T>&& source);
     virtual ~UndirectedUnlabeledGraph();
 
+    using UndirectedGraph<T>::DoesEdgeExist;
+    using UndirectedGraph<T>::GetEdgeWeight;
+
+    inline GraphStorage GetStorage() const { return storage; }
+    // the first real node id, nodes below it are padding without edges
+    inline long GetIdBase() const { return id_base; }
+    virtual double GetEdgeWeight(const long node_a, const long node_b) const;
+    virtual void SetEdgeWeight(const long node_a, const long node_b, const T weight);
+    // applies a batch of edge changes (see GraphEdge.h) under one lock,
+    // a weight of 0 removes the edge and the last change to a pair wins.
+    // Every id is checked before any change is made. Dense and Bitset
+    // storage are changed in place, the row based storages are merged
+    // with the sorted batch and rebuilt once (a Mapped graph becomes
+    // Sparse). Returns the sorted ids of the touched nodes
+    template <typename EdgeContainer>
+    std::vector<long> ApplyEdgeUpdates(const EdgeContainer& updates);
+    virtual long GetDegree(const long idx) const;
+    virtual std::vector<long> GetNeighbors(const long idx) const;
+    virtual NeighborRange Neighbors(const long idx) const;
+    // calls visit(neighbor, weight) for each neighbor of idx in the order
+    // of Neighbors(idx). Weights are read alongside the row instead of
+    // being looked up per edge, the same caveats as Neighbors apply
+    template <typename Visitor>
+    void ForEachNeighbor(const long idx, Visitor visit) const;
+    virtual SymMatrix<T> GetAdjacencyMatrix() const;
+    // memory maps an edge list of "a b weight" lines split on the read
+    // delimiter and parses it in place, replacing the graph like operator>>
+    // does. The file is cut at newlines into thread_count chunks that are
+    // parsed and sorted in parallel. Throws FileErr if the file cannot be opened
+    void ReadEdgeList(const std::string& file_name, const long thread_count = 1);
+    // loads a graph file of any GraphFileFormat, Text goes through
+    // ReadEdgeList and Snapshot through ReadSnapshot. The other formats are
+    // parsed from a memory mapping and deduplicated on thread_count threads.
+    // Throws FileErr if the file cannot be opened and FormatErr if it is malformed
+    void ReadGraph(const std::string& file_name, const GraphFileFormat format, const long thread_count = 1,
+      const double sparse_density = 0);
+    // reads a dense matrix file (see DenseMatrixReader.h) into the storage
+    // in use, parsing only the upper triangle. Only if sparse_density is
+    // above 0, Dense storage turns into Sparse when no more than that
+    // fraction of the upper triangle cells are non-zero, and the matrix is
+    // only allocated once it is exceeded. Check GetStorage() afterwards
+    void ReadDenseMatrix(const std::string& file_name, const double sparse_density = 0);
+    // maps a binary snapshot (see GraphSnapshot.h) and switches to Mapped
+    // storage, only the header is read unless verify asks for the O(n + m)
+    // row checks of MappedAdjacency::Open. Snapshots carry no labels.
+    // Throws FileErr if the file cannot be opened and FormatErr if it is
+    // not a snapshot
+    void ReadSnapshot(const std::string& file_name, const bool verify = false);
+    // writes the graph as a binary snapshot, with weights unless the
+    // storage only keeps presence. Throws FileErr if it cannot be written
+    void WriteSnapshot(const std::string& file_name) const;
+    // moves every node i and its label to new_ids[i], new_ids must be a permutation
+    void Relabel(const std::vector<long>& new_ids);
+
     friend ostream& operator<<(ostream& os, const UndirectedUnlabeledGraph& graph)
     {
-      os << graph.matrix << std::endl;
+      os << graph.GetAdjacencyMatrix() << std::endl;
       return os;
     }
 
     friend ifstream& operator>>(ifstream& is, UndirectedUnlabeledGraph<T>& graph)
     {
-      std::set<std::pair<long, long>> edges;
+      auto lock = graph.WriteLock();
+      graph.id_base = 0;
+      // undirected pairs are appended as (low, high), then sorted and
+      // deduplicated in one pass instead of inserted into a tree
+      std::vector<WeightedEdge> edges;
       long max_id = -1;
 
       std::string line;
@@ -35,19 +141,15 @@ class UndirectedUnlabeledGraph : public UndirectedGraph<T>
         auto w = atoi(ids.at(2).c_str());
 
         if (w > 0)
-          edges.insert(std::make_pair(a, b));
+          edges.push_back(WeightedEdge(std::make_pair<long, long>(std::min(a, b), std::max(a, b)), static_cast<T>(w)));
         if (a > max_id)
           max_id = a;
         if (b > max_id)
           max_id = b;
       }
 
-      graph.graph_size = max_id + 1;
-      graph.matrix = SymMatrix<T>(graph.graph_size);
-
-      for (const auto& itr : edges)
-        graph.matrix(itr.first, itr.second, 1);
-
+      SortEdges(edges, std::thread::hardware_concurrency());
+      graph.BuildStorage(max_id + 1, edges);
       return is;
     }
 };
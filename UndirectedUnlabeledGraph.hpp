@@ -1,18 +1,23 @@
 template <typename T>
-UndirectedUnlabeledGraph<T>::UndirectedUnlabeledGraph(const long size, const std::string& read_delim)
-: UndirectedGraph<T>(size), read_delimeter(read_delim)
+UndirectedUnlabeledGraph<T>::UndirectedUnlabeledGraph(const long size, const std::string& read_delim, const GraphStorage mode)
+: UndirectedGraph<T>(mode == GraphStorage::Dense ? size : 1), read_delimeter(read_delim), storage(mode),
+  id_base(0), sparse(mode == GraphStorage::Sparse ? size : 1), bitset(mode == GraphStorage::Bitset ? size : 1),
+  compressed(mode == GraphStorage::Compressed ? size : 1)
 {
+  this->ResizeLabels(size);
 }
 
 template <typename T>
 UndirectedUnlabeledGraph<T>::UndirectedUnlabeledGraph(const UndirectedUnlabeledGraph<T>& copy)
-: UndirectedGraph<T>(copy)
-{ 
+: UndirectedGraph<T>(copy), read_delimeter(copy.read_delimeter), storage(copy.storage), id_base(copy.id_base), sparse(copy.sparse), bitset(copy.bitset),
+  compressed(copy.compressed), mapped(copy.mapped)
+{
 }
 
 template <typename T>
 UndirectedUnlabeledGraph<T>::UndirectedUnlabeledGraph(UndirectedUnlabeledGraph<T>&& source)
-: UndirectedGraph<T>(source)
+: UndirectedGraph<T>(std::move(source)), read_delimeter(std::move(source.read_delimeter)), storage(source.storage), id_base(source.id_base),
+  sparse(std::move(source.sparse)), bitset(std::move(source.bitset)), compressed(std::move(source.compressed)), mapped(std::move(source.mapped))
 {
 }
 
@@ -20,3 +25,522 @@ template <typename T>
 UndirectedUnlabeledGraph<T>::~UndirectedUnlabeledGraph()
 {
 }
+
+template <typename T>
+double UndirectedUnlabeledGraph<T>::GetEdgeWeight(const long node_a, const long node_b) const
+{
+  if (storage == GraphStorage::Dense)
+    return UndirectedGraph<T>::GetEdgeWeight(node_a, node_b);
+
+  auto lock = this->ReadLock();
+  if (storage == GraphStorage::Bitset)
+    return bitset.GetEdgeWeight(node_a, node_b);
+  if (storage == GraphStorage::Compressed)
+    return compressed.GetEdgeWeight(node_a, node_b);
+  if (storage == GraphStorage::Mapped)
+    return mapped.GetEdgeWeight(node_a, node_b);
+  return sparse.GetEdgeWeight(node_a, node_b);
+}
+
+template <typename T>
+void UndirectedUnlabeledGraph<T>::SetEdgeWeight(const long node_a, const long node_b, const T weight)
+{
+  auto lock = this->WriteLock();
+  StoreEdgeWeight(node_a, node_b, weight);
+}
+
+template <typename T>
+template <typename EdgeContainer>
+std::vector<long> UndirectedUnlabeledGraph<T>::ApplyEdgeUpdates(const EdgeContainer& updates)
+{
+  auto lock = this->WriteLock();
+  // check the whole batch first so a bad id leaves the graph untouched
+  for (const auto& edge : updates)
+  {
+    if (EdgeSource(edge) < 0 || EdgeSource(edge) >= this->graph_size)
+      throw SubscriptErr(EdgeSource(edge));
+    if (EdgeTarget(edge) < 0 || EdgeTarget(edge) >= this->graph_size)
+      throw SubscriptErr(EdgeTarget(edge));
+  }
+
+  std::vector<long> touched;
+  touched.reserve(2 * updates.size());
+  for (const auto& edge : updates)
+  {
+    touched.push_back(EdgeSource(edge));
+    touched.push_back(EdgeTarget(edge));
+  }
+
+  if (storage == GraphStorage::Dense || storage == GraphStorage::Bitset)
+  {
+    // cells and bits change in place without moving the rest of the graph
+    for (const auto& edge : updates)
+      StoreEdgeWeight(EdgeSource(edge), EdgeTarget(edge), EdgeWeight<T>(edge));
+  }
+  else
+  {
+    // a single change to row storage shifts every row after it, so the
+    // sorted batch is merged with the current edges in one pass and the
+    // rows are rebuilt once, O(n + m + k log k) for k updates
+    std::vector<WeightedEdge> batch;
+    batch.reserve(updates.size());
+    for (const auto& edge : updates)
+    {
+      auto a = EdgeSource(edge);
+      auto b = EdgeTarget(edge);
+      batch.push_back(WeightedEdge(std::make_pair(std::min(a, b), std::max(a, b)), EdgeWeight<T>(edge)));
+    }
+    SortEdges(batch, 1);
+
+    // compressed rows keep no weights, so neither does their edge list
+    if (storage == GraphStorage::Compressed)
+    {
+      std::vector<std::pair<long, long>> merged;
+      MergeEdgeUpdates(batch, merged);
+      BuildStorage(this->graph_size, merged);
+    }
+    else
+    {
+      std::vector<WeightedEdge> merged;
+      MergeEdgeUpdates(batch, merged);
+      BuildStorage(this->graph_size, merged);
+    }
+  }
+
+  std::sort(touched.begin(), touched.end());
+  touched.erase(std::unique(touched.begin(), touched.end()), touched.end());
+  return touched;
+}
+
+template <typename T>
+template <typename Edge>
+void UndirectedUnlabeledGraph<T>::MergeEdgeUpdates(const std::vector<WeightedEdge>& batch, std::vector<Edge>& merged) const
+{
+  auto next = batch.begin();
+  auto take_updates_before = [&](const std::pair<long, long>& pair)
+  {
+    for (; next != batch.end() && next->first < pair; ++next)
+      if (next->second != 0)
+        AppendEdge(merged, next->first, next->second);
+  };
+  for (long a = 0; a < this->graph_size; a++)
+  {
+    ForEachNeighbor(a, [&](const long b, const double weight)
+    {
+      if (b < a)
+        return;
+      auto pair = std::make_pair(a, b);
+      take_updates_before(pair);
+      if (next != batch.end() && next->first == pair)
+      {
+        if (next->second != 0)
+          AppendEdge(merged, pair, next->second);
+        ++next;
+      }
+      else
+        AppendEdge(merged, pair, static_cast<T>(weight));
+    });
+  }
+  take_updates_before(std::make_pair(this->graph_size, this->graph_size));
+}
+
+template <typename T>
+void UndirectedUnlabeledGraph<T>::StoreEdgeWeight(const long node_a, const long node_b, const T weight)
+{
+  if (storage == GraphStorage::Mapped)
+    UnmapStorage();
+
+  if (storage == GraphStorage::Dense)
+    UndirectedGraph<T>::StoreEdgeWeight(node_a, node_b, weight);
+  else if (storage == GraphStorage::Bitset)
+    bitset.SetEdgeWeight(node_a, node_b, weight);
+  else if (storage == GraphStorage::Compressed)
+    compressed.SetEdgeWeight(node_a, node_b, weight);
+  else
+    sparse.SetEdgeWeight(node_a, node_b, weight);
+}
+
+template <typename T>
+long UndirectedUnlabeledGraph<T>::GetDegree(const long idx) const
+{
+  if (storage == GraphStorage::Dense)
+    return UndirectedGraph<T>::GetDegree(idx);
+
+  auto lock = this->ReadLock();
+  if (storage == GraphStorage::Bitset)
+    return bitset.GetDegree(idx);
+  if (storage == GraphStorage::Compressed)
+    return compressed.GetDegree(idx);
+  if (storage == GraphStorage::Mapped)
+    return mapped.GetDegree(idx);
+  return sparse.GetDegree(idx);
+}
+
+template <typename T>
+std::vector<long> UndirectedUnlabeledGraph<T>::GetNeighbors(const long idx) const
+{
+  if (storage == GraphStorage::Dense)
+    return UndirectedGraph<T>::GetNeighbors(idx);
+
+  auto lock = this->ReadLock();
+  if (storage == GraphStorage::Bitset)
+    return bitset.GetNeighbors(idx);
+  if (storage == GraphStorage::Compressed)
+    return compressed.GetNeighbors(idx);
+  if (storage == GraphStorage::Mapped)
+    return mapped.GetNeighbors(idx);
+  return sparse.GetNeighbors(idx);
+}
+
+template <typename T>
+NeighborRange UndirectedUnlabeledGraph<T>::Neighbors(const long idx) const
+{
+  if (storage == GraphStorage::Dense)
+    return UndirectedGraph<T>::Neighbors(idx);
+  if (storage == GraphStorage::Bitset)
+    return bitset.Neighbors(idx);
+  if (storage == GraphStorage::Compressed)
+    return compressed.Neighbors(idx);
+  if (storage == GraphStorage::Mapped)
+    return mapped.Neighbors(idx);
+  return sparse.Neighbors(idx);
+}
+
+template <typename T>
+template <typename Visitor>
+void UndirectedUnlabeledGraph<T>::ForEachNeighbor(const long idx, Visitor visit) const
+{
+  // presence only storage gives every edge weight 1
+  const T* weights = nullptr;
+  if (storage == GraphStorage::Sparse)
+    weights = sparse.NeighborWeights(idx);
+  else if (storage == GraphStorage::Mapped)
+    weights = mapped.NeighborWeights(idx);
+
+  for (const auto n : Neighbors(idx))
+  {
+    if (storage == GraphStorage::Dense)
+      visit(n, static_cast<double>(this->matrix(idx, n)));
+    else
+      visit(n, (weights != nullptr ? static_cast<double>(*weights++) : 1.0));
+  }
+}
+
+template <typename T>
+SymMatrix<T> UndirectedUnlabeledGraph<T>::GetAdjacencyMatrix() const
+{
+  if (storage == GraphStorage::Dense)
+    return UndirectedGraph<T>::GetAdjacencyMatrix();
+
+  SymMatrix<T> adjacency(this->graph_size);
+  for (long row = 0; row < this->graph_size; row++)
+  {
+    for (const auto col : Neighbors(row))
+    {
+      if (storage == GraphStorage::Sparse)
+        adjacency(row, col, sparse.GetEdgeWeight(row, col));
+      else if (storage == GraphStorage::Mapped)
+        adjacency(row, col, mapped.GetEdgeWeight(row, col));
+      else
+        adjacency(row, col, 1);
+    }
+  }
+  return adjacency;
+}
+
+template <typename T>
+void UndirectedUnlabeledGraph<T>::ReadEdgeList(const std::string& file_name, const long thread_count)
+{
+  MappedFile file(file_name);
+  auto lock = this->WriteLock();
+  id_base = 0;
+  const long chunk_count = std::max(1L, thread_count);
+
+  // cut the file into one chunk per thread, each ending on a newline
+  std::vector<const char*> bounds(chunk_count + 1, file.end());
+  bounds[0] = file.begin();
+  for (long i = 1; i < chunk_count; i++)
+  {
+    auto pos = std::max(bounds[i - 1], file.begin() + file.size() * i / chunk_count);
+    if (pos != file.begin() && pos != file.end() && *(pos - 1) != '\n')
+    {
+      pos = static_cast<const char*>(std::memchr(pos, '\n', file.end() - pos));
+      pos = (pos == nullptr ? file.end() : pos + 1);
+    }
+    bounds[i] = pos;
+  }
+
+  // every thread parses its chunk into a buffer of its own, undirected
+  // pairs are stored as (low, high) so (a, b) and (b, a) collapse into one
+  std::vector<std::vector<WeightedEdge>> buffers(chunk_count);
+  std::vector<long> max_ids(chunk_count, -1);
+  auto parse = [&](const long chunk)
+  {
+    auto& buffer = buffers[chunk];
+    auto& max_id = max_ids[chunk];
+    ScanEdgeList(bounds[chunk], bounds[chunk + 1], read_delimeter, [&](const long a, const long b, const long w)
+    {
+      if (w > 0)
+        buffer.push_back(WeightedEdge(std::make_pair(std::min(a, b), std::max(a, b)), static_cast<T>(w)));
+      if (a > max_id)
+        max_id = a;
+      if (b > max_id)
+        max_id = b;
+    });
+  };
+
+  std::vector<std::thread> workers;
+  for (long i = 1; i < chunk_count; i++)
+    workers.emplace_back(parse, i);
+  parse(0);
+  for (auto& worker : workers)
+    worker.join();
+
+  // the buffers are joined in file order so the sort keeps the last weight
+  std::vector<WeightedEdge> edges;
+  long total = 0;
+  for (const auto& buffer : buffers)
+    total += static_cast<long>(buffer.size());
+  edges.reserve(total);
+  for (auto& buffer : buffers)
+  {
+    edges.insert(edges.end(), buffer.begin(), buffer.end());
+    std::vector<WeightedEdge>().swap(buffer);
+  }
+  SortEdges(edges, chunk_count);
+
+  BuildStorage(*std::max_element(max_ids.begin(), max_ids.end()) + 1, edges);
+}
+
+template <typename T>
+void UndirectedUnlabeledGraph<T>::SortEdges(std::vector<WeightedEdge>& edges, const long thread_count)
+{
+  auto by_pair = [](const WeightedEdge& lhs, const WeightedEdge& rhs) { return lhs.first < rhs.first; };
+  const long slice_count = std::max(1L, std::min(thread_count, static_cast<long>(edges.size())));
+  std::vector<long> offsets(slice_count + 1);
+  for (long i = 0; i <= slice_count; i++)
+    offsets[i] = static_cast<long>(edges.size()) * i / slice_count;
+
+  // sort one slice per thread, then merge them pairwise. Both steps are
+  // stable, so equal pairs keep their order in edges
+  auto sort = [&](const long slice)
+  {
+    std::stable_sort(edges.begin() + offsets[slice], edges.begin() + offsets[slice + 1], by_pair);
+  };
+  std::vector<std::thread> workers;
+  for (long i = 1; i < slice_count; i++)
+    workers.emplace_back(sort, i);
+  sort(0);
+  for (auto& worker : workers)
+    worker.join();
+  for (long width = 1; width < slice_count; width *= 2)
+    for (long i = 0; i + width < slice_count; i += 2 * width)
+      std::inplace_merge(edges.begin() + offsets[i], edges.begin() + offsets[i + width],
+        edges.begin() + offsets[std::min(i + 2 * width, slice_count)], by_pair);
+
+  // keep the last entry of each run of equal node pairs
+  auto out = edges.begin();
+  for (auto itr = edges.begin(); itr != edges.end(); ++itr)
+    if (itr + 1 == edges.end() || (itr + 1)->first != itr->first)
+      *out++ = *itr;
+  edges.erase(out, edges.end());
+}
+
+template <typename T>
+void UndirectedUnlabeledGraph<T>::ReadGraph(const std::string& file_name, const GraphFileFormat format, const long thread_count,
+  const double sparse_density)
+{
+  if (format == GraphFileFormat::Text)
+  {
+    ReadEdgeList(file_name, thread_count);
+    return;
+  }
+  if (format == GraphFileFormat::Snapshot)
+  {
+    ReadSnapshot(file_name);
+    return;
+  }
+  if (format == GraphFileFormat::DenseMatrix)
+  {
+    ReadDenseMatrix(file_name, sparse_density);
+    return;
+  }
+
+  MappedFile file(file_name);
+  auto lock = this->WriteLock();
+  std::vector<WeightedEdge> edges;
+  long size = 0;
+  if (format == GraphFileFormat::Metis)
+    size = ParseMetisGraph(file.begin(), file.end(), edges, file_name);
+  else if (format == GraphFileFormat::MatrixMarket)
+    size = ParseMatrixMarket(file.begin(), file.end(), edges, file_name);
+  else
+    size = ParseSnapEdgeList(file.begin(), file.end(), edges, file_name);
+  id_base = ((format == GraphFileFormat::Metis || format == GraphFileFormat::MatrixMarket) ? 1 : 0);
+
+  SortEdges(edges, thread_count);
+  BuildStorage(size, edges);
+}
+
+template <typename T>
+void UndirectedUnlabeledGraph<T>::ReadDenseMatrix(const std::string& file_name, const double sparse_density)
+{
+  MappedFile file(file_name);
+  auto lock = this->WriteLock();
+  id_base = 0;
+  const char* pos = file.begin();
+  std::vector<std::string> labels;
+  auto size = ScanDenseHeader(pos, file.end(), labels, file_name);
+  if (storage == GraphStorage::Mapped)
+  {
+    storage = GraphStorage::Sparse;
+    mapped = MappedAdjacency<T>();
+  }
+
+  // with a sparse_density the cells are gathered as edges until there
+  // are too many for dense storage to go sparse, then they are moved
+  // into a full matrix. Without one, dense storage stays dense
+  const double dense_limit = sparse_density * size * (size + 1) / 2.0;
+  std::vector<WeightedEdge> edges;
+  bool dense = (storage == GraphStorage::Dense && sparse_density <= 0);
+  if (dense)
+    this->matrix = SymMatrix<T>(size);
+  ScanDenseRows<T>(pos, file.end(), size, [&](const long row, const long col, const T value)
+  {
+    if (dense)
+    {
+      this->matrix.Row(row)[col - row] = value;
+      return;
+    }
+
+    edges.push_back(WeightedEdge(std::make_pair(row, col), value));
+    if (storage == GraphStorage::Dense && edges.size() > dense_limit)
+    {
+      dense = true;
+      this->matrix = SymMatrix<T>(size);
+      for (const auto& edge : edges)
+        this->matrix.Row(EdgeSource(edge))[EdgeTarget(edge) - EdgeSource(edge)] = EdgeWeight<T>(edge);
+      std::vector<WeightedEdge>().swap(edges);
+    }
+  }, file_name);
+
+  if (dense)
+  {
+    this->ResizeLabels(size);
+    this->RebuildNeighborLists();
+  }
+  else
+  {
+    if (storage == GraphStorage::Dense)
+      storage = GraphStorage::Sparse;
+    BuildStorage(size, edges);
+  }
+
+  this->AssignLabels(labels);
+}
+
+template <typename T>
+void UndirectedUnlabeledGraph<T>::ReadSnapshot(const std::string& file_name, const bool verify)
+{
+  auto lock = this->WriteLock();
+  mapped.Open(file_name, verify);
+  storage = GraphStorage::Mapped;
+  id_base = 0;
+  this->matrix = SymMatrix<T>(1);
+  // no per node work, the graph is simply left without labels
+  std::vector<std::string> no_labels;
+  this->ResizeLabels(mapped.GetSize());
+  this->AssignLabels(no_labels);
+}
+
+template <typename T>
+void UndirectedUnlabeledGraph<T>::WriteSnapshot(const std::string& file_name) const
+{
+  bool weighted = (storage == GraphStorage::Dense || storage == GraphStorage::Sparse
+    || (storage == GraphStorage::Mapped && mapped.HasWeights()));
+  WriteGraphSnapshot<T>(file_name, *this, weighted);
+}
+
+template <typename T>
+void UndirectedUnlabeledGraph<T>::UnmapStorage()
+{
+  std::vector<WeightedEdge> edges;
+  for (long a = 0; a < mapped.GetSize(); a++)
+  {
+    ForEachNeighbor(a, [&](const long b, const double weight)
+    {
+      if (a <= b)
+        edges.push_back(std::make_pair(std::make_pair(a, b), static_cast<T>(weight)));
+    });
+  }
+
+  storage = GraphStorage::Sparse;
+  sparse.Build(mapped.GetSize(), edges);
+  mapped = MappedAdjacency<T>();
+}
+
+template <typename T>
+void UndirectedUnlabeledGraph<T>::Relabel(const std::vector<long>& new_ids)
+{
+  if (static_cast<long>(new_ids.size()) != this->graph_size)
+    throw SizeErr(this->graph_size, new_ids.size());
+
+  std::vector<WeightedEdge> edges;
+  for (long a = 0; a < this->graph_size; a++)
+  {
+    ForEachNeighbor(a, [&](const long b, const double weight)
+    {
+      if (a <= b)
+        edges.push_back(std::make_pair(std::make_pair(new_ids[a], new_ids[b]), static_cast<T>(weight)));
+    });
+  }
+
+  auto lock = this->WriteLock();
+  BuildStorage(this->graph_size, edges);
+
+  // the labels move with their nodes, so lookups by label still find them
+  if (this->node_labels)
+  {
+    std::vector<std::string> labels(this->graph_size);
+    for (long i = 0; i < this->graph_size; i++)
+      labels[new_ids[i]] = std::move(this->node_labels[i]);
+    this->AssignLabels(labels);
+  }
+}
+
+template <typename T>
+template <typename EdgeContainer>
+void UndirectedUnlabeledGraph<T>::BuildStorage(const long size, const EdgeContainer& edges)
+{
+  this->ResizeLabels(size);
+  if (storage == GraphStorage::Mapped)
+  {
+    // a snapshot cannot be rewritten in place, rebuilt graphs are sparse
+    storage = GraphStorage::Sparse;
+    mapped = MappedAdjacency<T>();
+  }
+
+  if (storage == GraphStorage::Sparse)
+  {
+    // the dense matrix is never allocated in sparse mode
+    this->matrix = SymMatrix<T>(1);
+    sparse.Build(size, edges);
+  }
+  else if (storage == GraphStorage::Bitset)
+  {
+    this->matrix = SymMatrix<T>(1);
+    bitset.Build(size, edges);
+  }
+  else if (storage == GraphStorage::Compressed)
+  {
+    this->matrix = SymMatrix<T>(1);
+    compressed.Build(size, edges);
+  }
+  else
+  {
+    this->matrix = SymMatrix<T>(size);
+    for (const auto& edge : edges)
+      this->matrix(EdgeSource(edge), EdgeTarget(edge), EdgeWeight<T>(edge));
+    this->RebuildNeighborLists();
+  }
+}
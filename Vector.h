@@ -60,6 +60,13 @@ class Vector
     // Post: the element in the ith dimension of the Vector
     // will be returned
     T& operator[](const long i) const;
+    // Desc: operator to access the element at the ith dimension
+    // without the cost of a subscript check in release builds
+    // Pre: i must be a positive value, no larger than the
+    // dimension - 1 of the calling Vector
+    // Post: the element in the ith dimension of the Vector
+    // will be returned, a bad subscript only throws in debug builds
+    inline T& Get(const long i) const { CheckSubscript(i, m_size); return m_data[i]; }
     // Desc: returns a new Vector with the value of
     // the calling Vector multiplied by a value d
     // Pre: the parameter d must be a type that
@@ -1,18 +1,48 @@
 #include "UndirectedUnlabeledGraph.h"
+#include "NodeOrdering.h"
 #include <set>
 #include <vector>
 #include <map>
 #include <queue>
+#include <limits>
+#include <unordered_map>
+#include <atomic>
+#include <thread>
+#include <functional>
+#include <cstring>
 using mType = long;
 using Partition = std::set<long>;
 using Parameters = std::map<std::string, std::string>;
+using EdgeUpdate = std::pair<std::pair<long, long>, mType>;
+// owner[id] is the index of the partition that claimed node id, or -1.
+// The threaded mode claims nodes through the atomic version
+using Ownership = std::vector<long>;
+using SharedOwnership = std::vector<std::atomic<long>>;
 
 void ReadStructures(const std::string& structure_file, std::vector<Partition>& structures);
-void SelectHotSpots(std::vector<Partition>& structures, Partition& hotspots, const long count, UndirectedUnlabeledGraph<mType>& graph);
+void SelectHotSpots(std::vector<Partition>& structures, Partition& hotspots, const long count, const UndirectedUnlabeledGraph<mType>& graph);
 void SortPartitions(std::vector<Partition>& structures);
-
-void DFS(Partition& partition, UndirectedUnlabeledGraph<mType>& graph, const long node_id, const long max_size, Partition& claimed_nodes);
-void BFS(Partition& partition, UndirectedUnlabeledGraph<mType>& graph, Partition& claimed_nodes);
+void MapNodeIds(std::vector<Partition>& node_sets, const std::vector<long>& ids);
+
+template <typename Owners>
+void DFS(Owners& owner, long& size, const UndirectedUnlabeledGraph<mType>& graph, const long node_id, const long max_size, const long part);
+template <typename Owners>
+void BFS(Owners& owner, const UndirectedUnlabeledGraph<mType>& graph, const std::vector<long>& seeds, const long part);
+template <typename Owners>
+void HeavyEdgeGrowth(Owners& owner, long& size, const UndirectedUnlabeledGraph<mType>& graph, const long node_id, const long max_size, const long part);
+void BalancedBFS(Ownership& owner, std::vector<long>& sizes, const UndirectedUnlabeledGraph<mType>& graph, const std::vector<std::vector<long>>& seeds, const long max_size);
+template <typename Owners>
+std::vector<std::vector<long>> PartitionMembers(const Owners& owner, const long count);
+bool ClaimNode(Ownership& owner, const long node_id, const long part);
+bool ClaimNode(SharedOwnership& owner, const long node_id, const long part);
+
+void ThreadedPartitioning(Ownership& owner, std::vector<long>& sizes, const UndirectedUnlabeledGraph<mType>& graph, const std::vector<long>& roots, const long max_size, const bool weighted, const bool balanced, const long fill_cap);
+void ForEachPartition(const long count, const std::function<void(long)>& grow);
+
+bool WriteAssignment(const std::string& output_file, const Ownership& owner, const long partition_count, const long id_base, const bool binary);
+bool ReadAssignment(const std::string& input_file, Ownership& owner, const long partition_count, const long id_base, const bool binary);
+void ReadEdgeUpdates(const std::string& update_file, const std::string& delimeter, std::vector<EdgeUpdate>& updates);
+void IncrementalRepartition(Ownership& owner, const long partition_count, const long max_size, const UndirectedUnlabeledGraph<mType>& graph, const Partition& hotspots, const std::vector<long>& changed_nodes);
 
 void ReadConfig(const std::string& file_path, Parameters& params);
 std::string GetParameter(const std::string& key, const Parameters& params, const std::string& def_val);
@@ -45,6 +75,22 @@ int main(int argc, char *argv[])
   bool use_threading = GetParameter("UseThreading", parameters, 0) != 0;
   bool fill_pool = GetParameter("FillPartitionFromStructure", parameters, 0) != 0;
   std::string graph_delimeter = GetParameter("GraphDelimeter", parameters, " ");
+  std::string graph_storage = GetParameter("GraphStorage", parameters, "dense");
+  std::string growth_mode = GetParameter("GrowthMode", parameters, "dfs");
+  std::string fill_mode = GetParameter("FillMode", parameters, "bfs");
+  long fill_cap = GetParameter("FillCap", parameters, 0);
+  std::string node_ordering = GetParameter("NodeOrdering", parameters, "none");
+  auto update_file = GetParameter("UpdateFilename", parameters, "");
+  auto assignment_file = GetParameter("AssignmentFilename", parameters, "");
+  std::string assignment_format = GetParameter("AssignmentFormat", parameters, "metis");
+  long load_threads = GetParameter("LoadThreads", parameters, 1);
+  std::string graph_format = GetParameter("GraphFormat", parameters, "auto");
+  auto snapshot_file = GetParameter("SnapshotFilename", parameters, "");
+  bool verify_snapshot = GetParameter("VerifySnapshot", parameters, 0) != 0;
+  // above 0, a sparse enough dense matrix file is stored as sparse even
+  // with GraphStorage=dense, 0 keeps the storage that was asked for
+  double sparse_density = GetParameter("SparseDensity", parameters, 0);
+  std::string output_format = GetParameter("OutputFormat", parameters, "verbose");
 
   if (graph_file == "")
   {
@@ -61,35 +107,138 @@ int main(int argc, char *argv[])
     std::cout << "Invalid value for key['PartitionCount']. Value must be greater than zero." << std::endl;
     return 0;
   }
-
-
-  ifstream file(graph_file);
-  if (!file.is_open())
+  if (load_threads <= 0)
   {
-    // on open fail, quit program
-    cout << "Could not open file" << endl;
-    return 1;
+    std::cout << "Invalid value for key['LoadThreads']. Value must be greater than zero." << std::endl;
+    return 0;
+  }
+  if (graph_format != "auto" && graph_format != "text" && graph_format != "snapshot"
+    && graph_format != "metis" && graph_format != "mtx" && graph_format != "snap" && graph_format != "matrix")
+  {
+    std::cout << "Invalid value for key['GraphFormat']. Value must be auto, text, snapshot, metis, mtx, snap or matrix." << std::endl;
+    return 0;
+  }
+  if (output_format != "verbose" && output_format != "metis" && output_format != "binary")
+  {
+    std::cout << "Invalid value for key['OutputFormat']. Value must be verbose, metis or binary." << std::endl;
+    return 0;
+  }
+  if (output_format != "verbose" && output_file == "")
+  {
+    std::cout << "Missing key['OutputFilename'] from configuration file, it is required by key['OutputFormat']." << std::endl;
+    return 0;
+  }
+  if (assignment_format != "metis" && assignment_format != "binary")
+  {
+    std::cout << "Invalid value for key['AssignmentFormat']. Value must be metis or binary." << std::endl;
+    return 0;
+  }
+  if (sparse_density < 0 || sparse_density > 1)
+  {
+    std::cout << "Invalid value for key['SparseDensity']. Value must be between 0 and 1." << std::endl;
+    return 0;
+  }
+  if (graph_storage != "dense" && graph_storage != "sparse" && graph_storage != "bitset" && graph_storage != "compressed")
+  {
+    std::cout << "Invalid value for key['GraphStorage']. Value must be dense, sparse, bitset or compressed." << std::endl;
+    return 0;
+  }
+  if (growth_mode != "dfs" && growth_mode != "weighted")
+  {
+    std::cout << "Invalid value for key['GrowthMode']. Value must be dfs or weighted." << std::endl;
+    return 0;
+  }
+  if (fill_mode != "bfs" && fill_mode != "balanced")
+  {
+    std::cout << "Invalid value for key['FillMode']. Value must be bfs or balanced." << std::endl;
+    return 0;
+  }
+  if (fill_cap < 0)
+  {
+    std::cout << "Invalid value for key['FillCap']. Value must be zero or greater." << std::endl;
+    return 0;
+  }
+  if (node_ordering != "none" && node_ordering != "rcm" && node_ordering != "bfs" && node_ordering != "degree")
+  {
+    std::cout << "Invalid value for key['NodeOrdering']. Value must be none, rcm, bfs or degree." << std::endl;
+    return 0;
   }
 
+
   // create the graph
   std::cout << "Reading graph file" << std::endl;
-  UndirectedUnlabeledGraph<mType> graph(1, graph_delimeter);
+  auto storage = GraphStorage::Dense;
+  if (graph_storage == "sparse")
+    storage = GraphStorage::Sparse;
+  else if (graph_storage == "bitset")
+    storage = GraphStorage::Bitset;
+  else if (graph_storage == "compressed")
+    storage = GraphStorage::Compressed;
+  UndirectedUnlabeledGraph<mType> graph(1, graph_delimeter, storage);
   try
   {
-    file >> graph;
+    // a snapshot is mapped as is, whatever GraphStorage says
+    auto format = GraphFileFormat::Text;
+    if (graph_format == "auto")
+      format = DetectGraphFormat(graph_file);
+    else if (graph_format == "snapshot")
+      format = GraphFileFormat::Snapshot;
+    else if (graph_format == "metis")
+      format = GraphFileFormat::Metis;
+    else if (graph_format == "mtx")
+      format = GraphFileFormat::MatrixMarket;
+    else if (graph_format == "snap")
+      format = GraphFileFormat::Snap;
+    else if (graph_format == "matrix")
+      format = GraphFileFormat::DenseMatrix;
+    if (format == GraphFileFormat::Snapshot && verify_snapshot)
+      graph.ReadSnapshot(graph_file, true);
+    else
+      graph.ReadGraph(graph_file, format, load_threads, sparse_density);
+    if (storage == GraphStorage::Dense && graph.GetStorage() == GraphStorage::Sparse)
+      std::cout << "Graph is below key['SparseDensity'], using sparse storage instead of dense" << std::endl;
+
+    // converting to a snapshot lets later runs load with GraphFormat=snapshot
+    if (snapshot_file != "")
+    {
+      std::cout << "Writing graph snapshot" << std::endl;
+      graph.WriteSnapshot(snapshot_file);
+    }
   }
   catch (MatrixErr& err)
   {
+    // on open fail, quit program
     cout << err.what() << endl;
     return 1;
   }
-  file.close();
+
+  // partition a relabeled copy of the graph whose neighbors sit close
+  // together in memory, original_ids[id] maps the new ids back
+  std::vector<long> original_ids;
+  std::vector<long> new_ids;
+  if (node_ordering != "none")
+  {
+    std::cout << "Reordering graph" << std::endl;
+    if (node_ordering == "rcm")
+      original_ids = ReverseCuthillMcKeeOrdering(graph);
+    else if (node_ordering == "bfs")
+      original_ids = BreadthFirstOrdering(graph);
+    else
+      original_ids = DegreeOrdering(graph);
+    new_ids = InvertOrdering(original_ids);
+    graph.Relabel(new_ids);
+  }
+
+  // partitioning only reads the graph, so let it skip the mutex
+  graph.Freeze();
 
   auto graph_size = graph.GetSize();
 
   std::cout << "Reading structure file" << std::endl;
   std::vector<Partition> structures;
   ReadStructures(structure_file, structures);  
+  if (!new_ids.empty())
+    MapNodeIds(structures, new_ids);
   
   std::cout << "Selecting hotspots" << std::endl;
   Partition hotspots;
@@ -97,83 +246,172 @@ int main(int argc, char *argv[])
 
   auto partition_size = graph_size / static_cast<double>(hotspots.size());
 
-  Partition claimed_nodes;
-  // the hotspots start the partitions
-  std::vector<Partition> partitions;
-  for (auto ht : hotspots)
+  // the hotspots start the partitions, in hotspot order, and every
+  // partition is tracked through owner until the output is written
+  std::vector<long> roots(hotspots.begin(), hotspots.end());
+  Ownership owner(graph_size, -1);
+  if (assignment_file != "")
   {
-    partitions.push_back({ht});
+    // pick up the partitions of an earlier run (an OutputFormat metis or
+    // binary file) instead of growing them again, so only the updates
+    // below are repartitioned
+    std::cout << "Reading assignment file" << std::endl;
+    if (!ReadAssignment(assignment_file, owner, static_cast<long>(roots.size()), graph.GetIdBase(), assignment_format == "binary"))
+    {
+      cout << "Could not read assignment file, it must hold one partition in [-1, " << roots.size() << ") per node" << endl;
+      return 1;
+    }
+    if (!new_ids.empty())
+    {
+      Ownership mapped(owner.size(), -1);
+      for (long i = 0; i < static_cast<long>(owner.size()); i++)
+        mapped[new_ids[i]] = owner[i];
+      owner.swap(mapped);
+    }
+  }
+  else
+  {
+    std::vector<long> sizes(roots.size(), 0);
+    for (long i = 0; i < static_cast<long>(roots.size()); i++)
+    {
+      owner[roots[i]] = i;
+      sizes[i]++;
+    }
     if (fill_pool)
     {
-      // put the remainder of the hotspot structures in the partitions if they will fit
-      for (const auto& st : structures)
+      for (long i = 0; i < static_cast<long>(roots.size()); i++)
       {
-        auto itr = st.find(ht);
-        if (itr != st.end())
+        // put the remainder of the hotspot structures in the partitions if they will fit,
+        // a node in the structures of several hotspots goes to the first of them
+        for (const auto& st : structures)
         {
-          if (st.size() <= partition_size)
+          auto itr = st.find(roots[i]);
+          if (itr != st.end() && st.size() <= partition_size)
           {
             for (const auto& pt : st)
-              partitions.back().insert(pt);
+            {
+              if (pt >= 0 && pt < graph_size && owner[pt] == -1)
+              {
+                owner[pt] = i;
+                sizes[i]++;
+              }
+            }
           }
         }
       }
     }
 
-    for (auto& node : partitions.back())
-      claimed_nodes.insert(node);
+    std::cout << "Partitioning..." << std::endl;
+    if (use_threading)
+    {
+      ThreadedPartitioning(owner, sizes, graph, roots, partition_size, growth_mode == "weighted", fill_mode == "balanced", fill_cap);
+    }
+    else
+    {
+      //no threading
+      for (long i = 0; i < static_cast<long>(roots.size()); i++)
+      {
+        if (growth_mode == "weighted")
+          HeavyEdgeGrowth(owner, sizes[i], graph, roots[i], partition_size, i);
+        else
+          DFS(owner, sizes[i], graph, roots[i], partition_size, i);
+      }
+
+      auto members = PartitionMembers(owner, static_cast<long>(roots.size()));
+      if (fill_mode == "balanced")
+        BalancedBFS(owner, sizes, graph, members, fill_cap);
+      else
+      {
+        for (long i = 0; i < static_cast<long>(roots.size()); i++)
+          BFS(owner, graph, members[i], i);
+      }
+    }
   }
 
-  std::cout << "Partitioning..." << std::endl;
-  // ignore the threading parameter for now
-  //if (use_threading || !use_threading)
-  //{
-    //use_threading
-  //}
-  //else
+  if (update_file != "")
   {
-    //no threading
-    // these are still ordered the same as the hotspots, so we don't need to find them again
-    long idx = 0;
-    for (auto ht : hotspots)
+    std::cout << "Applying graph updates" << std::endl;
+    std::vector<EdgeUpdate> updates;
+    ReadEdgeUpdates(update_file, graph_delimeter, updates);
+    if (!new_ids.empty())
     {
-      claimed_nodes.erase(ht);
-      DFS(partitions.at(idx++), graph, ht, partition_size, claimed_nodes);
+      for (auto& update : updates)
+      {
+        auto& edge = update.first;
+        if (edge.first >= 0 && edge.first < static_cast<long>(new_ids.size()))
+          edge.first = new_ids[edge.first];
+        if (edge.second >= 0 && edge.second < static_cast<long>(new_ids.size()))
+          edge.second = new_ids[edge.second];
+      }
     }
 
-    idx = 0;
-    for (auto ht : hotspots)
+    std::vector<long> changed_nodes;
+    graph.Thaw();
+    try
     {
-      BFS(partitions.at(idx++), graph, claimed_nodes);
+      changed_nodes = graph.ApplyEdgeUpdates(updates);
     }
+    catch (MatrixErr& err)
+    {
+      cout << err.what() << endl;
+      return 1;
+    }
+    graph.Freeze();
+
+    std::cout << "Repartitioning " << changed_nodes.size() << " nodes..." << std::endl;
+    IncrementalRepartition(owner, static_cast<long>(roots.size()), partition_size, graph, hotspots, changed_nodes);
   }
 
-  if (output_file != "")
+  // back to the ids of the graph file
+  if (!original_ids.empty())
   {
-    std::ofstream os(output_file.c_str());
-    if (os.is_open())
+    Ownership mapped(owner.size(), -1);
+    for (long i = 0; i < static_cast<long>(owner.size()); i++)
+      mapped[original_ids[i]] = owner[i];
+    owner.swap(mapped);
+  }
+
+  if (output_format != "verbose")
+  {
+    if (!WriteAssignment(output_file, owner, static_cast<long>(roots.size()), graph.GetIdBase(), output_format == "binary"))
     {
-      os << "Partition Count: " << partitions.size() << std::endl;
-      for (long i = 0; i < static_cast<long>(partitions.size()); i++)
-      {
-        os << "  [" << i << "]";
-        for (const auto id : partitions.at(i))
-          os << "    " << id << std::endl;
-      }
-      os << "Claimed " << claimed_nodes.size() << " of " << graph.GetSize() - 1 << std::endl;
-      os.close();
+      cout << "Could not write output file" << endl;
+      return 1;
     }
   }
   else
   {
-    std::cout << "Partition Count: " << partitions.size() << std::endl;
-    for (long i = 0; i < static_cast<long>(partitions.size()); i++)
+    // the partitions are only listed out for the verbose output
+    auto partitions = PartitionMembers(owner, static_cast<long>(roots.size()));
+    auto claimed = graph_size - std::count(owner.begin(), owner.end(), -1);
+    if (output_file != "")
     {
-      std::cout << "  [" << i << "]" << std::endl;
-      for (const auto id : partitions.at(i))
-        std::cout << "    " << id << std::endl;
+      std::ofstream os(output_file.c_str());
+      if (os.is_open())
+      {
+        // '\n' rather than std::endl so the stream is not flushed per node
+        os << "Partition Count: " << partitions.size() << std::endl;
+        for (long i = 0; i < static_cast<long>(partitions.size()); i++)
+        {
+          os << "  [" << i << "]";
+          for (const auto id : partitions.at(i))
+            os << "    " << id << '\n';
+        }
+        os << "Claimed " << claimed << " of " << graph.GetSize() - 1 << std::endl;
+        os.close();
+      }
+    }
+    else
+    {
+      std::cout << "Partition Count: " << partitions.size() << std::endl;
+      for (long i = 0; i < static_cast<long>(partitions.size()); i++)
+      {
+        std::cout << "  [" << i << "]" << '\n';
+        for (const auto id : partitions.at(i))
+          std::cout << "    " << id << '\n';
+      }
+      std::cout << "Claimed " << claimed << " of " << graph.GetSize() - 1 << std::endl;
     }
-    std::cout << "Claimed " << claimed_nodes.size() << " of " << graph.GetSize() - 1 << std::endl;
   }
 
   return 0;
@@ -181,32 +419,60 @@ int main(int argc, char *argv[])
 
 void ReadStructures(const std::string& structure_file, std::vector<Partition>& structures)
 {
-  std::ifstream file(structure_file.c_str());
-  if (file.is_open())
+  try
   {
-    std::string line;
-    while (std::getline(file, line))
+    MappedFile file(structure_file);
+    // structures are keyed by a hash of their sorted ids, so a line is
+    // only compared against the few structures that share its hash
+    std::unordered_multimap<uint64_t, long> seen;
+    std::vector<long> ids;
+    const char* eol = file.begin();
+    for (const char* line = file.begin(); line < file.end(); line = eol + 1)
     {
-      auto ids = split(line, " ");
-      Partition s;
-      for (long i = 1; i < static_cast<long>(ids.size()); i++)
-        s.insert(std::atoi(ids.at(i).c_str()));
+      eol = LineEnd(line, file.end());
 
-      if (s.size() > 0)
+      // the first field names the structure, the rest are its node ids.
+      // Fields are split on single spaces and read like atoi, as split() did
+      ids.clear();
+      auto field = FindDelimiter(line, eol, " ");
+      while (field != eol)
       {
-        bool match = false;
-        for (long i = 0; i < static_cast<long>(structures.size()) && !match; i++)
-          match = (structures.at(i) == s);
+        field += 1;
+        auto field_end = FindDelimiter(field, eol, " ");
+        ids.push_back(ScanLong(field, field_end));
+        field = field_end;
+      }
+      if (ids.empty())
+        continue;
+      std::sort(ids.begin(), ids.end());
+      ids.erase(std::unique(ids.begin(), ids.end()), ids.end());
+
+      uint64_t hash = 14695981039346656037ULL;
+      for (const auto id : ids)
+        hash = (hash ^ static_cast<uint64_t>(id)) * 1099511628211ULL;
+
+      bool match = false;
+      auto range = seen.equal_range(hash);
+      for (auto itr = range.first; itr != range.second && !match; ++itr)
+      {
+        const auto& st = structures.at(itr->second);
+        match = (st.size() == ids.size() && std::equal(ids.begin(), ids.end(), st.begin()));
+      }
 
-        if (!match)
-          structures.push_back(s);
+      if (!match)
+      {
+        seen.insert(std::make_pair(hash, static_cast<long>(structures.size())));
+        structures.push_back(Partition(ids.begin(), ids.end()));
       }
     }
-    file.close();
+  }
+  catch (MatrixErr& err)
+  {
+    std::cout << err.what() << std::endl;
   }
 }
 
-void SelectHotSpots(std::vector<Partition>& structures, Partition& hotspots, const long count, UndirectedUnlabeledGraph<mType>& graph)
+void SelectHotSpots(std::vector<Partition>& structures, Partition& hotspots, const long count, const UndirectedUnlabeledGraph<mType>& graph)
 {
   SortPartitions(structures);
 
@@ -254,27 +520,57 @@ void SortPartitions(std::vector<Partition>& structures)
   }
 }
 
-void DFS(Partition& partition, UndirectedUnlabeledGraph<mType>& graph, const long node_id, const long max_size, Partition& claimed_nodes)
+void MapNodeIds(std::vector<Partition>& node_sets, const std::vector<long>& ids)
 {
-  if (static_cast<long>(partition.size()) < max_size)
+  // ids outside of the graph are left alone
+  for (auto& node_set : node_sets)
   {
-    auto itr = claimed_nodes.find(node_id);
-    if (itr != claimed_nodes.end())
-      return;
+    Partition mapped;
+    for (const auto id : node_set)
+      mapped.insert((id >= 0 && id < static_cast<long>(ids.size())) ? ids[id] : id);
+    node_set.swap(mapped);
+  }
+}
 
-    partition.insert(node_id);
-    claimed_nodes.insert(node_id);
-    auto neighbors = graph.GetNeighbors(node_id);
+template <typename Owners>
+void DFS(Owners& owner, long& size, const UndirectedUnlabeledGraph<mType>& graph, const long node_id, const long max_size, const long part)
+{
+  // node_id is already part's, the search claims outward from it.
+  // An explicit stack instead of recursion, so chains of any length fit.
+  // Each entry is a node on the current path and the neighbors it has
+  // left to try, which keeps the visit order of the recursive version.
+  // The stack is kept between calls so its storage is only grown once
+  typedef std::pair<NeighborRange::const_iterator, NeighborRange::const_iterator> Frame;
+  static thread_local std::vector<Frame> stack;
+  stack.clear();
+
+  auto neighbors = graph.Neighbors(node_id);
+  stack.push_back(Frame(neighbors.begin(), neighbors.end()));
+  while (!stack.empty() && size < max_size)
+  {
+    auto& frame = stack.back();
+    if (frame.first == frame.second)
+    {
+      stack.pop_back();
+      continue;
+    }
 
-    for (long i = 0; i < static_cast<long>(neighbors.size()); i++)
-      DFS(partition, graph, neighbors.at(i), max_size, claimed_nodes);
+    auto node = *frame.first;
+    ++frame.first;
+    if (!ClaimNode(owner, node, part))
+      continue;
+
+    size++;
+    neighbors = graph.Neighbors(node);
+    stack.push_back(Frame(neighbors.begin(), neighbors.end()));
   }
 }
 
-void BFS(Partition& partition, UndirectedUnlabeledGraph<mType>& graph, Partition& claimed_nodes)
+template <typename Owners>
+void BFS(Owners& owner, const UndirectedUnlabeledGraph<mType>& graph, const std::vector<long>& seeds, const long part)
 {
   std::queue<long> que;
-  for (auto& node : partition)
+  for (auto& node : seeds)
     que.push(node);
 
   while (static_cast<long>(que.size()) > 0)
@@ -282,20 +578,379 @@ void BFS(Partition& partition, UndirectedUnlabeledGraph<mType>& graph, Partition
     auto node_id = que.front();
     que.pop();
 
-    auto neighbors = graph.GetNeighbors(node_id);
-    for (auto& n : neighbors)
+    for (const auto n : graph.Neighbors(node_id))
+      if (ClaimNode(owner, n, part))
+        que.push(n);
+  }
+}
+
+template <typename Owners>
+void HeavyEdgeGrowth(Owners& owner, long& size, const UndirectedUnlabeledGraph<mType>& graph, const long node_id, const long max_size, const long part)
+{
+  // best-first growth: always claim the unclaimed node at the end of
+  // the heaviest edge leaving the partition, so heavy edges stay internal.
+  // node_id is already part's, so the frontier starts at its neighbors
+  std::priority_queue<std::pair<double, long>> frontier;
+  auto push_unclaimed = [&](const long n, const double weight)
+  {
+    if (owner[n] == -1)
+      frontier.push(std::make_pair(weight, n));
+  };
+  graph.ForEachNeighbor(node_id, push_unclaimed);
+
+  while (!frontier.empty() && size < max_size)
+  {
+    auto node = frontier.top().second;
+    frontier.pop();
+
+    if (!ClaimNode(owner, node, part))
+      continue;
+
+    size++;
+    graph.ForEachNeighbor(node, push_unclaimed);
+  }
+}
+
+void BalancedBFS(Ownership& owner, std::vector<long>& sizes, const UndirectedUnlabeledGraph<mType>& graph, const std::vector<std::vector<long>>& seeds, const long max_size)
+{
+  // every partition runs its own BFS from seeds, but they take turns one
+  // claimed node at a time and the turn always goes to the smallest
+  // partition, ties to the lowest index. A partition drops out once its
+  // BFS runs dry or it holds max_size nodes, 0 meaning no limit
+  const long count = static_cast<long>(seeds.size());
+  const long limit = (max_size > 0 ? max_size : std::numeric_limits<long>::max());
+  std::vector<std::queue<long>> ques(count);
+  // the neighbors of the node each partition is expanding that are left to try
+  std::vector<NeighborRange::const_iterator> next(count);
+  std::vector<NeighborRange::const_iterator> last(count);
+  std::priority_queue<std::pair<long, long>, std::vector<std::pair<long, long>>, std::greater<std::pair<long, long>>> turns;
+  for (long i = 0; i < count; i++)
+  {
+    for (const auto node : seeds[i])
+      ques[i].push(node);
+    if (sizes[i] < limit)
+      turns.push(std::make_pair(sizes[i], i));
+  }
+
+  while (!turns.empty())
+  {
+    auto part = turns.top().second;
+    turns.pop();
+
+    bool claimed = false;
+    while (!claimed)
+    {
+      if (next[part] == last[part])
+      {
+        if (ques[part].empty())
+          break;
+        auto neighbors = graph.Neighbors(ques[part].front());
+        ques[part].pop();
+        next[part] = neighbors.begin();
+        last[part] = neighbors.end();
+        continue;
+      }
+
+      auto n = *next[part];
+      ++next[part];
+      if (ClaimNode(owner, n, part))
+      {
+        ques[part].push(n);
+        claimed = true;
+      }
+    }
+
+    if (claimed && ++sizes[part] < limit)
+      turns.push(std::make_pair(sizes[part], part));
+  }
+}
+
+template <typename Owners>
+std::vector<std::vector<long>> PartitionMembers(const Owners& owner, const long count)
+{
+  // one pass over the nodes, so every list comes out in id order
+  std::vector<std::vector<long>> members(count);
+  for (long i = 0; i < static_cast<long>(owner.size()); i++)
+  {
+    long part = owner[i];
+    if (part != -1)
+      members[part].push_back(i);
+  }
+  return members;
+}
+
+bool ClaimNode(Ownership& owner, const long node_id, const long part)
+{
+  if (owner[node_id] != -1)
+    return false;
+  owner[node_id] = part;
+  return true;
+}
+
+bool ClaimNode(SharedOwnership& owner, const long node_id, const long part)
+{
+  long unclaimed = -1;
+  return owner[node_id].compare_exchange_strong(unclaimed, part);
+}
+
+bool WriteAssignment(const std::string& output_file, const Ownership& owner, const long partition_count, const long id_base, const bool binary)
+{
+  // assignment[id] is the partition of node id, or -1 if no partition claimed it
+  std::vector<int32_t> assignment(owner.begin(), owner.end());
+
+  std::ofstream os(output_file.c_str(), std::ios::binary | std::ios::trunc);
+  if (!os.is_open())
+    return false;
+
+  // binary: the raw array of node_count native int32 values indexed by
+  // node id, padding ids below id_base included. Unclaimed nodes are -1
+  if (binary)
+  {
+    os.write(reinterpret_cast<const char*>(assignment.data()), assignment.size() * sizeof(int32_t));
+    return os.good();
+  }
+
+  // metis: line i holds the partition of node id_base + i, so a 1 based
+  // graph file gets one line per vertex as METIS tools expect. Every
+  // line must name a partition, so each unclaimed node (one no partition
+  // could reach) goes to the partition that is smallest at that point,
+  // ties to the lowest index
+  if (partition_count < 1)
+    return false;
+  std::vector<long> sizes(partition_count, 0);
+  for (long i = id_base; i < static_cast<long>(assignment.size()); i++)
+    if (assignment[i] != -1)
+      sizes[assignment[i]]++;
+  std::priority_queue<std::pair<long, long>, std::vector<std::pair<long, long>>, std::greater<std::pair<long, long>>> smallest;
+  for (long i = 0; i < partition_count; i++)
+    smallest.push(std::make_pair(sizes[i], i));
+  for (long i = id_base; i < static_cast<long>(assignment.size()); i++)
+  {
+    if (assignment[i] != -1)
+      continue;
+    auto part = smallest.top().second;
+    smallest.pop();
+    assignment[i] = static_cast<int32_t>(part);
+    smallest.push(std::make_pair(++sizes[part], part));
+  }
+
+  // the lines are formatted by hand into a large buffer that is written
+  // out whenever it fills
+  const std::size_t buffer_size = 1 << 20;
+  std::vector<char> buffer;
+  buffer.reserve(buffer_size);
+  char digits[16];
+  for (long i = id_base; i < static_cast<long>(assignment.size()); i++)
+  {
+    if (buffer.size() + sizeof(digits) > buffer_size)
+    {
+      os.write(buffer.data(), buffer.size());
+      buffer.clear();
+    }
+
+    long value = assignment[i];
+    long count = 0;
+    do
+    {
+      digits[count++] = static_cast<char>('0' + value % 10);
+      value /= 10;
+    } while (value > 0);
+    while (count > 0)
+      buffer.push_back(digits[--count]);
+    buffer.push_back('\n');
+  }
+  os.write(buffer.data(), buffer.size());
+  return os.good();
+}
+
+bool ReadAssignment(const std::string& input_file, Ownership& owner, const long partition_count, const long id_base, const bool binary)
+{
+  // either format of WriteAssignment, with exactly one entry per node.
+  // Metis files start at node id_base, the padding nodes stay unclaimed
+  try
+  {
+    MappedFile file(input_file);
+    if (binary)
+    {
+      if (file.size() != owner.size() * sizeof(int32_t))
+        return false;
+      std::vector<int32_t> assignment(owner.size());
+      std::memcpy(assignment.data(), file.begin(), file.size());
+      std::copy(assignment.begin(), assignment.end(), owner.begin());
+    }
+    else
+    {
+      long count = id_base;
+      const char* eol = file.begin();
+      for (const char* line = file.begin(); line < file.end(); line = eol + 1)
+      {
+        eol = LineEnd(line, file.end());
+        long part = 0;
+        if (!ScanLongToken(line, eol, part))
+          continue;
+        if (count == static_cast<long>(owner.size()))
+          return false;
+        owner[count++] = part;
+      }
+      if (count != static_cast<long>(owner.size()))
+        return false;
+    }
+  }
+  catch (MatrixErr& err)
+  {
+    std::cout << err.what() << std::endl;
+    return false;
+  }
+
+  for (const auto part : owner)
+    if (part < -1 || part >= partition_count)
+      return false;
+  return true;
+}
+
+void ReadEdgeUpdates(const std::string& update_file, const std::string& delimeter, std::vector<EdgeUpdate>& updates)
+{
+  // same "a b weight" lines as the graph file, a weight of 0 removes the edge
+  try
+  {
+    MappedFile file(update_file);
+    ScanEdgeList(file.begin(), file.end(), delimeter, [&](const long a, const long b, const long w)
+    {
+      updates.push_back(std::make_pair(std::make_pair(a, b), (w > 0 ? w : 0)));
+    });
+  }
+  catch (MatrixErr& err)
+  {
+    std::cout << err.what() << std::endl;
+  }
+}
+
+void IncrementalRepartition(Ownership& owner, const long partition_count, const long max_size, const UndirectedUnlabeledGraph<mType>& graph, const Partition& hotspots, const std::vector<long>& changed_nodes)
+{
+  // a partition takes nodes only while it is below max_size, or below
+  // its size before the updates if the BFS fill already took it past that
+  std::vector<long> sizes(partition_count, 0);
+  for (const auto part : owner)
+    if (part != -1)
+      sizes[part]++;
+  std::vector<long> limits(partition_count);
+  for (long i = 0; i < partition_count; i++)
+    limits[i] = std::max(max_size, sizes[i]);
+
+  // only the nodes whose neighborhood changed are released,
+  // hotspots stay put since they anchor their partitions
+  std::vector<long> released;
+  for (const auto node : changed_nodes)
+  {
+    if (hotspots.find(node) != hotspots.end())
+      continue;
+    if (owner[node] != -1)
+      sizes[owner[node]]--;
+    owner[node] = -1;
+    released.push_back(node);
+  }
+
+  // each released node joins the partition with room it has the heaviest
+  // edges to, ties go to the lowest partition. Isolated nodes and nodes
+  // whose partitions are all full stay unclaimed
+  std::vector<double> pull(partition_count, 0);
+  std::queue<long> que;
+  for (const auto node : released)
+  {
+    long best = -1;
+    graph.ForEachNeighbor(node, [&](const long n, const double weight)
+    {
+      auto part = owner[n];
+      if (part == -1)
+        return;
+      pull[part] += weight;
+      if (sizes[part] < limits[part] && (best == -1 || pull[part] > pull[best] || (pull[part] == pull[best] && part < best)))
+        best = part;
+    });
+    for (const auto n : graph.Neighbors(node))
+      if (owner[n] != -1)
+        pull[owner[n]] = 0;
+
+    if (best != -1)
+    {
+      owner[node] = best;
+      sizes[best]++;
+      que.push(node);
+    }
+  }
+
+  // as in BFS, nodes an inserted edge made reachable join their neighbor's
+  // partition, a full partition leaves them for another one to reach
+  while (!que.empty())
+  {
+    auto node_id = que.front();
+    que.pop();
+
+    auto part = owner[node_id];
+    for (const auto n : graph.Neighbors(node_id))
     {
-      auto itr = claimed_nodes.find(n);
-      if (itr == claimed_nodes.end())
+      if (owner[n] == -1 && sizes[part] < limits[part])
       {
-        partition.insert(n);
-        claimed_nodes.insert(n);
+        owner[n] = part;
+        sizes[part]++;
         que.push(n);
       }
     }
   }
 }
 
+void ThreadedPartitioning(Ownership& owner, std::vector<long>& sizes, const UndirectedUnlabeledGraph<mType>& graph, const std::vector<long>& roots, const long max_size, const bool weighted, const bool balanced, const long fill_cap)
+{
+  SharedOwnership shared(owner.size());
+  for (long i = 0; i < static_cast<long>(owner.size()); i++)
+    shared[i].store(owner[i]);
+
+  // every partition grows on its own up to max_size, then once they all
+  // have, they race breadth first for whatever nodes are left. A node
+  // belongs to the first partition whose compare and swap claims it
+  ForEachPartition(static_cast<long>(roots.size()), [&](const long part)
+  {
+    if (weighted)
+      HeavyEdgeGrowth(shared, sizes[part], graph, roots[part], max_size, part);
+    else
+      DFS(shared, sizes[part], graph, roots[part], max_size, part);
+  });
+  auto members = PartitionMembers(shared, static_cast<long>(roots.size()));
+  if (!balanced)
+  {
+    ForEachPartition(static_cast<long>(roots.size()), [&](const long part)
+    {
+      BFS(shared, graph, members[part], part);
+    });
+  }
+
+  for (long i = 0; i < static_cast<long>(owner.size()); i++)
+    owner[i] = shared[i].load();
+
+  // the balanced fill hands out one node at a time, so it runs on this thread
+  if (balanced)
+    BalancedBFS(owner, sizes, graph, members, fill_cap);
+}
+
+void ForEachPartition(const long count, const std::function<void(long)>& grow)
+{
+  // one worker per core, each taking the next partition that is left
+  std::atomic<long> next(0);
+  auto work = [&]()
+  {
+    for (long part = next++; part < count; part = next++)
+      grow(part);
+  };
+
+  long thread_count = std::min(count, std::max(1L, static_cast<long>(std::thread::hardware_concurrency())));
+  std::vector<std::thread> workers;
+  for (long i = 1; i < thread_count; i++)
+    workers.emplace_back(work);
+  work();
+  for (auto& worker : workers)
+    worker.join();
+}
+
 void ReadConfig(const std::string& file_path, Parameters& params)
 {
   std::ifstream file(file_path.c_str());